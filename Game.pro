@@ -1,6 +1,6 @@
 QT       += core gui
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+greaterThan(QT_MAJOR_VERSION, 4): QT += widgets concurrent
 
 CONFIG += c++20
 QMAKE_CXXFLAGS += -fconcepts-diagnostics-depth=200
@@ -8,31 +8,12 @@ QMAKE_CXXFLAGS += -fconcepts-diagnostics-depth=200
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+include(model/model.pri)
+
 SOURCES += \
+    controller/actionqueue.cpp \
     controller/gamecontroller.cpp \
     main.cpp \
-    model/behaviors/attack.cpp \
-    model/behaviors/behavior.cpp \
-    model/behaviors/concrete/attack/counterattackbehavior.cpp \
-    model/behaviors/concrete/attack/genericattackbehavior.cpp \
-    model/behaviors/concrete/health/generichealingbehavior.cpp \
-    model/behaviors/concrete/health/generichealthbehavior.cpp \
-    model/behaviors/concrete/movement/genericmovebehavior.cpp \
-    model/behaviors/concrete/movement/genericwalkablebehavior.cpp \
-    model/behaviors/concrete/movement/healonstepbehavior.cpp \
-    model/behaviors/concrete/movement/newlevelonstep.cpp \
-    model/behaviors/concrete/movement/poisononstepbehavior.cpp \
-    model/behaviors/concrete/movement/randommovementbehavior.cpp \
-    model/behaviors/concrete/poison/genericpoisonablebehavior.cpp \
-    model/behaviors/concrete/health/poisononkilledbehavior.cpp \
-    model/behaviors/concrete/poison/genericpoisoningbehavior.cpp \
-    model/behaviors/health.cpp \
-    model/behaviors/movement.cpp \
-    model/behaviors/poison.cpp \
-    model/gameobject.cpp \
-    model/gameobjectmodel.cpp \
-    model/modelfactory.cpp \
-    model/noise/perlinnoise.cpp \
     view/gamepixmapitem.cpp \
     view/gameview.cpp \
     view/gamewindow.cpp \
@@ -42,32 +23,8 @@ SOURCES += \
     view/renderer/spriterenderer.cpp
 
 HEADERS += \
+    controller/actionqueue.h \
     controller/gamecontroller.h \
-    model/behaviors/attack.h \
-    model/behaviors/behavior.h \
-    model/behaviors/concrete/attack/counterattackbehavior.h \
-    model/behaviors/concrete/attack/genericattackbehavior.h \
-    model/behaviors/concrete/health/generichealingbehavior.h \
-    model/behaviors/concrete/health/generichealthbehavior.h \
-    model/behaviors/concrete/movement/genericmovebehavior.h \
-    model/behaviors/concrete/movement/genericwalkablebehavior.h \
-    model/behaviors/concrete/movement/healonstepbehavior.h \
-    model/behaviors/concrete/movement/newlevelonstep.h \
-    model/behaviors/concrete/movement/poisononstepbehavior.h \
-    model/behaviors/concrete/movement/randommovementbehavior.h \
-    model/behaviors/concrete/poison/genericpoisonablebehavior.h \
-    model/behaviors/concrete/health/poisononkilledbehavior.h \
-    model/behaviors/concrete/poison/genericpoisoningbehavior.h \
-    model/behaviors/health.h \
-    model/behaviors/movement.h \
-    model/behaviors/poison.h \
-    model/gameobject.h \
-    model/gameobjectmodel.h \
-    model/gameobjectsettings.h \
-    model/modelfactory.h \
-    model/noise/perlinnoise.h \
-    node.h \
-    publicenums.h \
     view/gamepixmapitem.h \
     view/gameview.h \
     view/gamewindow.h \
@@ -88,18 +45,6 @@ RESOURCES += qdarkstyle/dark/darkstyle.qrc
 #RESOURCES += qdarkstyle/light/lightstyle.qrc
 RESOURCES += Resources.qrc
 
-win32:CONFIG(release, debug|release): LIBS += -L$$PWD/../lib/ -lworl
-else:win32:CONFIG(debug, debug|release): LIBS += -L$$PWD/../lib/ -lworld
-
-INCLUDEPATH += $$PWD/../worldsource
-DEPENDPATH += $$PWD/../worldsource
-
-
-unix:!macx: LIBS += -L$$PWD/../worldlib/ -lworld
-
-#INCLUDEPATH += $$PWD/../worldlib
-#DEPENDPATH += $$PWD/../worldlib
-
 DISTFILES += \
     README.md \
     docs/ARCH.md \
@@ -0,0 +1,42 @@
+#include "actionqueue.h"
+
+ActionQueue::ActionQueue(QObject *parent)
+    : QObject(parent) {
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &ActionQueue::runNext);
+}
+
+void ActionQueue::enqueue(int delay, Action action) {
+    m_actions.enqueue({qMax(0, delay), std::move(action)});
+    startNext();
+}
+
+void ActionQueue::clear() {
+    m_timer.stop();
+    m_actions.clear();
+}
+
+void ActionQueue::setPaused(bool paused) {
+    m_paused = paused;
+    if(paused) {
+        m_timer.stop();
+    } else {
+        startNext();
+    }
+}
+
+void ActionQueue::startNext() {
+    if(!m_paused && !m_actions.isEmpty() && !m_timer.isActive()) {
+        m_timer.start(m_actions.head().delay);
+    }
+}
+
+void ActionQueue::runNext() {
+    if(m_actions.isEmpty()) {
+        return;
+    }
+    // The action can clear the queue or add to it, the next one is started afterwards.
+    auto action = m_actions.dequeue().action;
+    action();
+    startNext();
+}
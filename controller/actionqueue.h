@@ -0,0 +1,87 @@
+#ifndef ACTIONQUEUE_H
+#define ACTIONQUEUE_H
+
+#include <QObject>
+#include <QQueue>
+#include <QTimer>
+#include <functional>
+
+/**
+ * @brief The ActionQueue class runs the actions of the controller one after the other, each one after its delay.
+ * The delays are waited for by a single shot QTimer, so the event loop sleeps in between instead of spinning.
+ * An action can queue the next ones, the walks of the pathfinder queue their next step this way.
+ * Pausing stops the timer, the action that was waiting gets its whole delay again when the queue is resumed.
+ */
+class ActionQueue : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief Action Something the controller does, like a move or an attack.
+     */
+    using Action = std::function<void()>;
+
+    /**
+     * @brief ActionQueue constructor.
+     * @param parent The parent QObject.
+     */
+    explicit ActionQueue(QObject *parent = nullptr);
+
+    /**
+     * @brief enqueue Adds an action at the end of the queue.
+     * @param delay How many milliseconds to wait before it runs, 0 runs it on the next pass of the event loop.
+     * @param action The action.
+     */
+    void enqueue(int delay, Action action);
+
+    /**
+     * @brief clear Drops every action that did not run yet.
+     */
+    void clear();
+
+    /**
+     * @brief setPaused Stops or resumes the queue, the actions are kept.
+     */
+    void setPaused(bool paused);
+
+    ///@{
+    /**
+     * @brief Getters
+     **/
+    bool isPaused() const { return m_paused; }
+    bool isEmpty() const { return m_actions.isEmpty(); }
+    ///@}
+
+private:
+    /**
+     * @brief The Entry struct is an action with its delay.
+     */
+    struct Entry {
+        int delay;
+        Action action;
+    };
+
+    /**
+     * @brief startNext Starts the delay of the first action, unless the queue is paused or already waiting.
+     */
+    void startNext();
+
+    /**
+     * @brief runNext Runs the first action, when its delay is over.
+     */
+    void runNext();
+
+    /**
+     * @brief m_actions The actions that did not run yet, the first one is the one being waited for.
+     */
+    QQueue<Entry> m_actions;
+    /**
+     * @brief m_timer Waits for the delay of the first action.
+     */
+    QTimer m_timer;
+    /**
+     * @brief m_paused If the queue is stopped.
+     */
+    bool m_paused = false;
+};
+
+#endif // ACTIONQUEUE_H
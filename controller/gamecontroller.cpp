@@ -1,10 +1,11 @@
-#include <node.h>
+#include <QRandomGenerator>
 
 #include "gamecontroller.h"
+#include "model/gamerandom.h"
 #include "model/modelfactory.h"
+#include "model/savegame.h"
 #include "model/behaviors/attack.h"
 #include "model/behaviors/movement.h"
-#include "pathfinder_class.h"
 #include "view/renderer/spriterenderer.h"
 #include "view/renderer/textrenderer.h"
 #include "view/renderer/colorrenderer.h"
@@ -12,6 +13,9 @@
 void GameController::startGame() {
     m_view = QSharedPointer<GameView>::create(this); // Instantiate the GameView
     m_view->setRenderer(QSharedPointer<SpriteRenderer>::create()); // Instantiate and set the default renderer
+    connect(&m_pathService, &PathService::pathFound, this, &GameController::followPath);
+    // Every game is different, a loaded one goes on with the generator it was saved with.
+    GameRandom::global().seed(QRandomGenerator::system()->generate());
     createNewLevel(m_gameLevel); // Create first level
     this->show();
 }
@@ -32,11 +36,7 @@ void GameController::updateLevel(Direction direction) {
 
     } else {
         qDebug() << "Switching to existing model for level " << newLevel;
-        auto *model = m_models[newLevel].first;
-        if(!model) {
-            qDebug() << "Error: Model is null at level " << newLevel;
-            return;
-        }
+        auto *model = restoreLevel(newLevel);
 
         m_gameLevel = newLevel;
         m_enemies = 10 * (m_gameLevel + 1) + 25;
@@ -51,42 +51,148 @@ void GameController::updateLevel(Direction direction) {
     emitLevelUpdates();
 }
 
+LevelParameters GameController::levelParameters(int level) const {
+    int tiles = m_levelSize.width() * m_levelSize.height();
+    unsigned int enemies = tiles / 20 + (level + 1) * sqrt(tiles) / 10;
+    int healthPacks = sqrt(tiles) / 4 - (level / 5);
+    return {level,
+            enemies,
+            (unsigned int)qMax(0, healthPacks),
+            0.5f,
+            m_levelSize.height(),
+            m_levelSize.width(),
+            GameRandom::global().levelSeed(level)};
+}
+
 void GameController::createNewLevel(int level) {
     // Set the level parameters
-    int tiles = m_levelSize.width() * m_levelSize.height();
+    auto parameters = levelParameters(level);
     m_gameLevel = level;
-    m_enemies = tiles / 20 + (level + 1) * sqrt(tiles) / 10;
-    m_health_packs = sqrt(tiles) / 4 - (level / 5);
-    // Call the model factory to generate model
-    auto model = ObjectModelFactory::createModel(m_enemies, m_health_packs, 0.5f, m_gameLevel,
-                                                 m_levelSize.height(), m_levelSize.width());
+    m_enemies = parameters.nrOfEnemies;
+    m_health_packs = parameters.nrOfHealthpacks;
+    // The data is usually prefetched already, only the GameObjects are made here on the GUI thread.
+    auto model = ObjectModelFactory::createModel(m_pregenerator.take(parameters));
     m_models.append(model);
     model.first->setParent(this);
+    touchLevel(level);
     // Set the character aka protagonist
     auto oldCharacter = m_protagonist;
     m_protagonist = model.first->getObject(ObjectType::Protagonist).at(0);
 
     if(oldCharacter) {
-        m_protagonist->setData(oldCharacter->getAllData().at(0));
+        // The new protagonist keeps its own id, ids belong to the level.
+        auto data = oldCharacter->getData();
+        data[DataRole::Id] = m_protagonist->getData(DataRole::Id);
+        m_protagonist->setData(data);
     }
 
     // Create new scene
     m_view->createScene(model.first->getAllData());
     connectCurrentModel(); // Reconnect new model
     emitLevelUpdates(); // Signal changes to the window
+
+    // The next level is built in the background while this one is played.
+    m_pregenerator.prefetch(levelParameters(level + 1));
+}
+
+GameObjectModel *GameController::restoreLevel(int level) {
+    if(!m_models[level].first) {
+        // The level was evicted, it is built again from its snapshot.
+        m_models[level] = m_snapshots.take(level).restore();
+        m_models[level].first->setParent(this);
+    }
+    touchLevel(level);
+    return m_models[level].first;
+}
+
+bool GameController::saveGame(const QString &fileName) const {
+    SaveGame save;
+    save.currentLevel = m_gameLevel;
+    save.seed = GameRandom::global().gameSeed();
+    save.randomState = GameRandom::global().state();
+    for(int level = 0; level < m_models.size(); ++level) {
+        auto *model = m_models[level].first;
+        save.levels.append(model ? LevelSnapshot::capture(*model) : m_snapshots[level]);
+    }
+    return save.save(fileName);
+}
+
+bool GameController::loadGame(const QString &fileName) {
+    SaveGame save;
+    if(!save.load(fileName)) {
+        return false;
+    }
+
+    // Drop the game being played, every level of the save starts as a snapshot.
+    m_pregenerator.cancel();
+    stopPath();
+    disconnectCurrentModel();
+    for(const auto &entry : m_models) {
+        if(entry.first) {
+            entry.first->deleteLater();
+        }
+    }
+    m_models.clear();
+    m_snapshots.clear();
+    m_liveLevels.clear();
+    for(int level = 0; level < save.levels.size(); ++level) {
+        m_models.append({nullptr, {}});
+        m_snapshots.insert(level, save.levels[level]);
+    }
+
+    m_gameLevel = save.currentLevel;
+    // The state was checked by SaveGame::load(), the levels that are still to come are the ones of the saved game.
+    GameRandom::global().restore(save.seed, save.randomState);
+    setState(State::Running);
+    auto parameters = levelParameters(m_gameLevel);
+    m_enemies = parameters.nrOfEnemies;
+    m_health_packs = parameters.nrOfHealthpacks;
+
+    auto *model = restoreLevel(m_gameLevel);
+    m_protagonist = model->getObject(ObjectType::Protagonist).at(0);
+    m_view->createScene(model->getAllData());
+    connectCurrentModel();
+    updateEnergy();
+    updateHealth();
+    emitLevelUpdates();
+
+    m_pregenerator.prefetch(levelParameters(m_models.size()));
+    return true;
+}
+
+void GameController::touchLevel(int level) {
+    m_liveLevels.removeOne(level);
+    m_liveLevels.append(level);
+
+    // The level being played is the most recent one, it is never evicted.
+    while(m_liveLevels.size() > qMax(1, m_levelBudget)) {
+        int evicted = m_liveLevels.takeFirst();
+        auto &entry = m_models[evicted];
+        m_snapshots.insert(evicted, LevelSnapshot::capture(*entry.first, entry.second));
+        // The level might still be sending the change that made us leave it.
+        entry.first->deleteLater();
+        entry = {nullptr, {}};
+    }
 }
 
 void GameController::disconnectCurrentModel() {
+    // A path searched on the level that is left is of no use anymore.
+    m_pathService.cancel();
     auto *model = m_models[m_gameLevel].first;
     disconnect(model, &GameObjectModel::dataChanged, m_view.get(), &GameView::dataChanged);
     disconnect(this, &GameController::tick, model, &GameObjectModel::tick);
     disconnect(model, &GameObjectModel::dataChanged, this, &GameController::dataChanged);
+    disconnect(model, &GameObjectModel::tilesAdded, m_view.get(), &GameView::addTiles);
+    disconnect(model, &GameObjectModel::tilesRemoved, m_view.get(), &GameView::removeTiles);
 }
 void GameController::connectCurrentModel() {
     auto *model = m_models[m_gameLevel].first;
     connect(model, &GameObjectModel::dataChanged, m_view.get(), &GameView::dataChanged);
     connect(this, &GameController::tick, model, &GameObjectModel::tick);
     connect(model, &GameObjectModel::dataChanged, this, &GameController::dataChanged);
+    // Streamed levels add and remove the tiles of their chunks as the protagonist moves.
+    connect(model, &GameObjectModel::tilesAdded, m_view.get(), &GameView::addTiles);
+    connect(model, &GameObjectModel::tilesRemoved, m_view.get(), &GameView::removeTiles);
 }
 
 void GameController::emitLevelUpdates() {
@@ -95,7 +201,18 @@ void GameController::emitLevelUpdates() {
     emit levelUpdated(m_gameLevel);
 }
 
-void GameController::dataChanged(QMap<DataRole, QVariant> objectData) {
+void GameController::dataChanged(QList<QMap<DataRole, QVariant>> changes) {
+    int level = m_gameLevel;
+    for(const auto &objectData : changes) {
+        handleChange(objectData);
+        // The rest of the batch belongs to the level that was just left.
+        if(level != m_gameLevel) {
+            return;
+        }
+    }
+}
+
+void GameController::handleChange(const QMap<DataRole, QVariant> &objectData) {
     // Filter the changes based on their type
     switch(objectData[DataRole::Type].value<ObjectType>()) {
     case ObjectType::Protagonist:
@@ -121,81 +238,137 @@ void GameController::dataChanged(QMap<DataRole, QVariant> objectData) {
         break;
     }
 }
-void GameController::automaticAttack() {
-    // Find the enemy and attack it until it dies.
-    auto target = m_protagonist->getNeighbor(m_protagonist->getData(DataRole::Direction).toDouble())
-                    ->findChild({ObjectType::_ENEMIES_START, ObjectType::_ENEMIES_END});
-
-    while(m_gameState != State::GameOver && target && target->getData(DataRole::Health).toInt()) {
-        QTime time = QTime::currentTime().addMSecs(200);
-        while(QTime::currentTime() < time) {
-            QCoreApplication::processEvents(QEventLoop::AllEvents, 200);
-        }
+void GameController::automaticAttack(Direction direction) {
+    if(m_walk.level != m_gameLevel || m_gameState == State::GameOver) {
+        finishWalk();
+        return;
+    }
+
+    // Attack the enemy until it dies, one attack per turn.
+    QPointer<GameObject> target;
+    if(auto tile = m_protagonist->getNeighbor(direction)) {
+        target = tile->findChild({ObjectType::_ENEMIES_START, ObjectType::_ENEMIES_END});
+    }
+    if(target && target->getData(DataRole::Health).toInt()) {
         characterAttack();
+        // The counter attack can end the game, that stops the walk.
+        if(m_gameState == State::GameOver) {
+            return;
+        }
+        if(target->getData(DataRole::Health).toInt()) {
+            m_actions.enqueue(2 * m_pacing, [this, direction] { automaticAttack(direction); });
+            return;
+        }
     }
+    moveStep(direction);
+}
+
+void GameController::executePath(std::vector<int> path, bool full, DStarLite *planner) {
+    // Mark the path from the tile at the start position, without building the chunks it crosses.
+    auto pos = qobject_cast<GameObject *>(m_protagonist->parent())->getData(DataRole::Position).toPoint();
+    m_models[m_gameLevel].first->markPath(pos, path);
+
+    // The steps are taken by the timer of the queue, the event loop sleeps in between.
+    m_actions.clear();
+    m_walk = {std::move(path), 0, full, planner, m_gameLevel};
+    m_actions.enqueue(m_pacing, [this] { walkStep(); });
+}
+
+void GameController::stopPath() {
+    m_actions.clear();
+    m_walk = {};
 }
 
-void GameController::executePath(std::vector<int> path, bool full) {
-    // Tile at the start position
-    auto first_tile = qobject_cast<GameObject *>(m_protagonist->parent());
-    for(int move : path) {
-        // Assign the path tiles to DataRole Path
-        first_tile = first_tile->getNeighbor(((45 * move + 90) % 360));
-        first_tile->setData(DataRole::Path, true);
+void GameController::walkStep() {
+    // The rest of the path belongs to the level that was left while waiting.
+    if(m_walk.level != m_gameLevel || m_gameState == State::GameOver) {
+        finishWalk();
+        return;
     }
 
-    for(int move : path) {
-        Direction direction = (Direction)((45 * move + 90) % 360);
+    auto tile = qobject_cast<GameObject *>(m_protagonist->parent());
+    int move = -1;
+    if(m_walk.planner) {
+        // The planner repairs its tree with what changed since the last step, no need to search again.
+        QPoint pos = tile->getData(DataRole::Position).toPoint();
+        move = m_walk.planner->nextMove(pos);
+        if(move >= 0) {
+            m_models[m_gameLevel].first->markPath(pos, {move});
+        }
+    } else if(m_walk.step < m_walk.path.size()) {
+        move = m_walk.path[m_walk.step];
+    }
+    if(move < 0) {
+        finishWalk();
+        return;
+    }
+    Direction direction = (Direction)((45 * move + 90) % 360);
 
-        // Quick Delay for visualization
-        QTime dieTime = QTime::currentTime().addMSecs(100);
-        while(QTime::currentTime() < dieTime)
-            QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+    if(direction != m_protagonist->getData(DataRole::Direction).value<Direction>()) {
+        characterMove(direction);
+    }
 
-        if(direction != m_protagonist->getData(DataRole::Direction).value<Direction>()) {
-            characterMove(direction);
+    // Check whether enemy is on the way of the path and attack it
+    if(auto tile = m_protagonist->getNeighbor(direction)) {
+        if(tile->hasChild({ObjectType::_ENEMIES_START, ObjectType::_ENEMIES_END})) {
+            m_actions.enqueue(2 * m_pacing, [this, direction] { automaticAttack(direction); });
+            return;
         }
+    }
+    moveStep(direction);
+}
 
-        // Check whether enemy is on the way of the path and attack it
-        if(auto tile = m_protagonist->getNeighbor(direction)) {
-            if(tile->hasChild({ObjectType::_ENEMIES_START, ObjectType::_ENEMIES_END})) {
-                automaticAttack();
-            }
+void GameController::moveStep(Direction direction) {
+    // Play fully automatic
+    if(m_walk.full) {
+        auto *model = m_models[m_gameLevel].first;
+        QPoint charPos = qobject_cast<GameObject *>(m_protagonist->parent())->getData(DataRole::Position).toPoint();
+        DistanceField *field = nullptr;
+        // Find enemy or healthpack if energy or health too low. Number is sort of arbitrary
+        if(m_protagonist->getData(DataRole::Energy).toInt() < 80 || m_protagonist->getData(DataRole::PoisonLevel).toInt() > 15) {
+            field = &model->getDistanceField(DistanceField::Target::Enemies);
+
+        } else if(m_protagonist->getData(DataRole::Health).toInt() < 80) {
+            field = &model->getDistanceField(DistanceField::Target::HealthPacks);
         }
-        // Play fully automatic
-        if(full) {
-            QPointer<const GameObject> obj;
-            // Find enemy or healthpack if energy or health too low. Number is sort of arbitrary
-            if(m_protagonist->getData(DataRole::Energy).toInt() < 80 || m_protagonist->getData(DataRole::PoisonLevel).toInt() > 15) {
-                obj = m_protagonist->nearest({ObjectType::_ENEMIES_START, ObjectType::_ENEMIES_END});
-
-            } else if(m_protagonist->getData(DataRole::Health).toInt() < 80) {
-                obj = m_protagonist->nearest(ObjectType::HealthPack);
-            }
-            // Can be that there are no HP or enemies left.
-            if(obj) {
-                QPoint objPos = obj->getData(DataRole::Position).toPoint();
-                QPoint charPos = m_protagonist->getData(DataRole::Position).toPoint();
-                QPoint doorPos(m_models[m_gameLevel].first->getColumnCount(),
-                               m_models[m_gameLevel].first->getRowCount());
-                int distObj = (objPos - charPos).manhattanLength();
-                int distDoor = (doorPos - charPos).manhattanLength();
-                // Check if the distance to the door is smaller than the distance to the object.
-                if(distObj < distDoor) {
-                    pathFinder(objPos.x(), objPos.y());
-                }
-                // After we go to the object, return to the pathfinder function that called this.
-                // That function will schedule itself after this function finishes.
+        // The fields already know the cost to the closest target and to the door, no need to search.
+        // Can be that there are no HP or enemies left, then the distance is infinite.
+        if(field && field->distance(charPos) < model->getDistanceField(DistanceField::Target::Exit).distance(charPos)) {
+            auto detour = field->path(charPos);
+            if(!detour.empty()) {
+                // After we go to the object, the pathfinder is run again when the detour is over.
+                executePath(detour, false);
+                m_walk.detour = true;
                 return;
             }
         }
-        characterMove(direction);
     }
+
+    auto tile = m_protagonist->parent();
+    characterMove(direction);
+    m_walk.step++;
+
+    // Without the energy for the next tile the planner would keep asking for it.
+    if(m_walk.planner && m_protagonist->parent() == tile) {
+        stopPath();
+        return;
+    }
+    m_actions.enqueue(m_pacing, [this] { walkStep(); });
+}
+
+void GameController::finishWalk() {
+    // Run the pathfinder again in the next event loop if the game is on full auto and the walk got somewhere.
+    // A detour of full auto always goes back to it, the object it went for might have been next to the protagonist.
+    if(((m_walk.full && m_walk.step > 0) || m_walk.detour) && m_gameState != State::GameOver) {
+        m_actions.enqueue(0, [this] { pathFinder(); });
+    }
+    m_walk = {};
 }
 
 void GameController::pathFinder(int x, int y) {
     bool full = (x == -1 && y == -1);
-    auto nodes = m_models[m_gameLevel].second; // Node class for the pathfinder
+    // A new goal replaces the walk that is going on.
+    stopPath();
 
     int rows = m_models[m_gameLevel].first->getRowCount();
     int cols = m_models[m_gameLevel].first->getColumnCount();
@@ -203,28 +376,43 @@ void GameController::pathFinder(int x, int y) {
     // Get protagonist position in the world = start position of the pathfinder
     auto pos = static_cast<GameObject *>(m_protagonist->parent())->getData(DataRole::Position).toPoint();
 
-    Comparator<Node> comp = [](const Node &a, const Node &b) {
-        return a.h > b.h;
-    };
     // Check for non valid input position
     if(x >= cols || y >= rows || x < 0 || y < 0) {
         y = rows - 1;
         x = cols - 1;
     }
 
-    auto *start = &nodes[cols * pos.y() + pos.x()];
-    auto *dest = &nodes[cols * y + x];
-    PathFinder<Node, Node> pathFinder(nodes, start, dest, comp, cols, 0.001f);
-
-    // Call the algorithm
-    auto path = pathFinder.A_star();
+    // Levels without a ClusterGraph are small enough to be searched right away by their planner. It walks the path
+    // it found and keeps its tree: the steps only repair what changed, and so does full auto after the detours
+    // as long as the goal stays.
+    auto &entry = m_models[m_gameLevel];
+    m_autoPlay = full;
+    if(!entry.second->hasClusters()) {
+        auto &planner = entry.first->getPlanner();
+        planner.setGoal(QPoint(x, y));
+        auto path = planner.path(pos);
+        executePath(path, full, &planner);
+        return;
+    }
 
-    executePath(path, full);
+    // A search on a big level can take a while, the GUI keeps running while a worker does it.
+    m_pathService.request(entry.second, pos, QPoint(x, y));
+}
 
-    // Run the method again in the next event loop if the game is on full auto.
-    if(full) {
-        QMetaObject::invokeMethod(this, "pathFinder", Qt::QueuedConnection, -1, -1);
+void GameController::followPath(QPoint from, QPoint to, std::vector<int> path) {
+    // The path starts where the protagonist was when it was asked for.
+    auto pos = static_cast<GameObject *>(m_protagonist->parent())->getData(DataRole::Position).toPoint();
+    if(pos != from) {
+        if(m_autoPlay) {
+            pathFinder();
+        } else {
+            pathFinder(to.x(), to.y());
+        }
+        return;
     }
+
+    // Big levels walk the path of the worker as it is, the planner takes too much memory there.
+    executePath(path, m_autoPlay);
 }
 
 void GameController::updateEnergy() {
@@ -232,7 +420,7 @@ void GameController::updateEnergy() {
     emit energyUpdated(protagonistEnergy);
 
     if(protagonistEnergy == 0) {
-        m_gameState = State::GameOver;
+        setState(State::GameOver);
         emit gameOver();
     }
 }
@@ -242,15 +430,21 @@ void GameController::updateHealth() {
     emit healthUpdated(protagonistHealth);
 
     if(protagonistHealth == 0) {
-        m_gameState = State::GameOver;
+        setState(State::GameOver);
         emit gameOver();
     }
 }
 
-void GameController::characterMove(Direction to) {
-    while(m_gameState == State::Paused)
-        QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
+void GameController::setState(State new_state) {
+    m_gameState = new_state;
+    // The walk waits where it is while the game is paused.
+    m_actions.setPaused(new_state == State::Paused);
+    if(new_state == State::GameOver) {
+        stopPath();
+    }
+}
 
+void GameController::characterMove(Direction to) {
     if(m_gameState == State::Running) {
         if(auto move = m_protagonist->getBehavior<Movement>()) {
             move->stepOn(to);
@@ -260,9 +454,6 @@ void GameController::characterMove(Direction to) {
 }
 
 void GameController::characterAttack() {
-    while(m_gameState == State::Paused)
-        QCoreApplication::processEvents(QEventLoop::AllEvents, 100);
-
     if(m_gameState == State::Running) {
         if(auto attack = m_protagonist->getBehavior<Attack>()) {
             attack->attack();
@@ -10,8 +10,12 @@
 #include <qdatetime.h>
 #include <QDateTime>
 
-#include "node.h"
+#include "controller/actionqueue.h"
 #include "model/gameobjectmodel.h"
+#include "model/levelpregenerator.h"
+#include "model/levelsnapshot.h"
+#include "model/pathfinding/pathservice.h"
+#include "model/pathfinding/pathworkspace.h"
 #include "view/gameview.h"
 
 /**
@@ -77,10 +81,15 @@ public:
      */
     void updateGameView(View view);
     /**
-     * @brief dataChanged captures any model changes and filters to call corresponding methods.
+     * @brief dataChanged captures the batch of model changes of a tick and filters them to call corresponding methods.
+     * @param changes the data that changed, one map per change.
+     */
+    void dataChanged(QList<QMap<DataRole, QVariant>> changes);
+    /**
+     * @brief handleChange calls the corresponding methods for one change of a batch.
      * @param objectData the data that changed.
      */
-    void dataChanged(QMap<DataRole, QVariant> objectData);
+    void handleChange(const QMap<DataRole, QVariant> &objectData);
     /**
      * @brief emitLevelUpdates emits changing level, health packs and enemies signals upon changing levels, signals captured by GameWindow.
      */
@@ -92,23 +101,45 @@ public:
     void createNewLevel(int level);
     /**
      * @brief automaticAttack Attack function used by the pathfinder, to automatically attack enemies in the path or when the enrgy is low.
+     * Attacks once and queues the next attack until the enemy dies, the walk goes on with the move afterwards.
+     * @param direction the move of the walk that the enemy is standing on.
      */
-    void automaticAttack();
+    void automaticAttack(Direction direction);
     /**
-     * @brief executePath Executes the moves returned y the pathfinder.
+     * @brief executePath Executes the moves returned y the pathfinder. The steps are queued one after the other,
+     * so this returns right away and the path is walked while the event loop runs. It replaces the walk that was going on.
      * @param path to take.
      * @param fully Boolean indicating whether or not to keep executing throughout new levels, so keep finding for the rest of the game.
+     * @param planner If set, every step is asked to the planner instead, so the walk follows the changes of the level.
+     * The path is then only marked as the planned one.
+     */
+    void executePath(std::vector<int> path, bool fully = false, DStarLite *planner = nullptr);
+    /**
+     * @brief saveGame writes every level and the current level to a file.
+     * @param fileName the file to write.
+     * @return false if the file could not be written.
+     */
+    bool saveGame(const QString &fileName) const;
+    /**
+     * @brief loadGame replaces the game with a saved one. Only the current level is rebuilt, the others stay snapshots until they are visited.
+     * @param fileName the file to read.
+     * @return false if the file is not a valid save, the game is then unchanged.
      */
-    void executePath(std::vector<int> path, bool fully = false);
+    bool loadGame(const QString &fileName);
     ///@{
     /**
      * @brief Getters and setters
      **/
-    void setState(State new_state) { m_gameState = new_state; }
+    void setState(State new_state); // Pausing stops the queued actions
     void setView(QSharedPointer<GameView> view) { m_view = view; } // GameView
+    void setLevelBudget(int levels) { m_levelBudget = levels; } // Levels kept as GameObjects, at least 1
+    void setPacing(int milliseconds) { m_pacing = qMax(0, milliseconds); } // Time between the steps of a walk, 0 walks as fast as possible
+    int getPacing() { return m_pacing; }
     State getState() { return m_gameState; }
     QSharedPointer<GameView> getView() { return m_view; } // GameView
     View getGameView() { return m_gameView; } // Visualization enum
+    const LevelPregenerator::Stats &getPrefetchStats() const { return m_pregenerator.stats(); } // How often the next level was ready
+    const PathService::Stats &getPathStats() const { return m_pathService.stats(); } // The searches of the worker
     ///@}
 public slots:
     /**
@@ -118,6 +149,15 @@ public slots:
      */
     void pathFinder(int x = -1, int y = -1);
 
+private slots:
+    /**
+     * @brief followPath walks a path found by the PathService.
+     * @param from where the search started, the protagonist might have moved since.
+     * @param to the goal of the path.
+     * @param path the moves.
+     */
+    void followPath(QPoint from, QPoint to, std::vector<int> path);
+
 signals:
     /**
      * @brief tick Emitted when a turn is complete.
@@ -156,8 +196,22 @@ signals:
 private:
     /**
      * @brief m_model List of the different game models for different levels, holds all game data and logic.
+     * Every level has its own PathWorkspace for the pathfinder, shared with the PathService while it searches.
+     * The model of an evicted level is null, the level is in m_snapshots.
+     */
+    QList<QPair<GameObjectModel *, QSharedPointer<PathWorkspace>>> m_models;
+    /**
+     * @brief m_snapshots The levels that are not live anymore, by level number.
+     */
+    QMap<int, LevelSnapshot> m_snapshots;
+    /**
+     * @brief m_liveLevels The levels that have a model, least recently played first.
+     */
+    QList<int> m_liveLevels;
+    /**
+     * @brief m_levelBudget How many levels are kept as GameObjects, the least recently played ones are snapshotted.
      */
-    QList<QPair<GameObjectModel *, std::vector<Node>>> m_models;
+    int m_levelBudget = 3;
     /**
      * @brief m_view The scene of the controller.
      */
@@ -190,6 +244,76 @@ private:
      * @brief m_levelSize Size of the levels.
      */
     QSize m_levelSize;
+    /**
+     * @brief m_pregenerator Builds the data of the next level while the current one is played.
+     */
+    LevelPregenerator m_pregenerator;
+    /**
+     * @brief m_pathService Runs the searches of the pathfinder on a worker thread.
+     */
+    PathService m_pathService;
+    /**
+     * @brief m_autoPlay If the path being searched is one of full auto.
+     */
+    bool m_autoPlay = false;
+    /**
+     * @brief m_actions The steps and attacks of the walk, run one after the other by a timer.
+     */
+    ActionQueue m_actions;
+    /**
+     * @brief m_pacing Milliseconds between the steps of a walk, attacks take twice as long.
+     */
+    int m_pacing = 100;
+    /**
+     * @brief The Walk struct is the path the queued steps are walking.
+     */
+    struct Walk {
+        std::vector<int> path;
+        size_t step = 0;
+        bool full = false; // Run the pathfinder again when the walk is over
+        DStarLite *planner = nullptr;
+        int level = -1; // The walk stops when this level is left
+        bool detour = false; // Going for an enemy or a health pack on full auto, which goes on when it is over
+    };
+    /**
+     * @brief m_walk The walk that is going on, if m_actions is not empty.
+     */
+    Walk m_walk;
+    /**
+     * @brief levelParameters the parameters of a new level, the number of enemies and health packs depend on the level.
+     * @param level the level number.
+     * @return the parameters for the ObjectModelFactory.
+     */
+    LevelParameters levelParameters(int level) const;
+    /**
+     * @brief restoreLevel gets the model of a level, rebuilding it from its snapshot if it was evicted, and marks it as the most recently played.
+     * @param level the level number.
+     * @return the model of the level.
+     */
+    GameObjectModel *restoreLevel(int level);
+    /**
+     * @brief touchLevel marks a level as the most recently played one and evicts the levels over the budget.
+     * @param level the level number.
+     */
+    void touchLevel(int level);
+    /**
+     * @brief stopPath Stops the walk that is going on, the step that is queued is dropped.
+     */
+    void stopPath();
+    /**
+     * @brief walkStep Takes the next step of the walk: turns, attacks the enemy in the way if any and moves.
+     */
+    void walkStep();
+    /**
+     * @brief moveStep Moves in the direction of the step and queues the next one.
+     * On full auto it goes for an enemy or a health pack first if the protagonist needs it.
+     * @param direction the direction of the step.
+     */
+    void moveStep(Direction direction);
+    /**
+     * @brief finishWalk Ends the walk, full auto then looks for the next path.
+     */
+    void finishWalk();
     /**
      * @brief disconnectCurrentModel disconnects current model upon changing levels.
      */
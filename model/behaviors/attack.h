@@ -10,6 +10,11 @@
  */
 class Attack : public Behavior {
 public:
+    /**
+     * @brief SLOT The slot of this interface in a GameObject.
+     */
+    static constexpr BehaviorSlot SLOT = BehaviorSlot::Attack;
+
     /**
      * @brief Attack default constructor.
      * @param owner the object to which this behavior applies.
@@ -1,5 +1,10 @@
 #include "behavior.h"
+#include "model/gameobject.h"
 
 Behavior::~Behavior() {};
 
-
+void Behavior::wake(int delay) {
+    if(m_owner) {
+        m_owner->schedule(sharedFromThis(), delay);
+    }
+}
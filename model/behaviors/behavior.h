@@ -3,22 +3,34 @@
 
 #include <QPointer>
 #include <QSharedPointer>
+#include <QtGlobal>
 
 // Foward declaration of GameObject
 class GameObject;
 
+/**
+ * @brief The BehaviorSlot enum gives every behavior interface a fixed slot in its GameObject.
+ * An object has at most one behavior per interface, so the slot is known at compile time.
+ */
+enum class BehaviorSlot { Attack, Health, Movement, Poison, Count };
+
 /**
  * @brief The Behavior class is a marker interface (abstract class) that all the behaviors have to extend.
  * This is not a pure interface since it does store one reference to the owner of the behavior.
+ * Time based behaviors override tick() and ask the TickScheduler of their level for ticks with wake().
+ * Behaviors without state of their own can be shared (flyweights): one instance made by shared() is used by
+ * every GameObject of an archetype. A shared behavior has no owner, the methods that act on the owner get
+ * it as an argument, and it never gets ticks.
  */
-class Behavior {
+class Behavior : public QEnableSharedFromThis<Behavior> {
 public:
     /**
      * @brief Behavior default constructor.
      * @param owner the owner of the behavior.
      */
     Behavior(QPointer<GameObject> owner)
-        : m_owner(owner) {};
+        : m_owner(owner)
+        , m_shared(owner.isNull()) {};
 
     ///@{
     /// Interface without default constructor
@@ -28,10 +40,63 @@ public:
         return *this;
     };
     ///@}
+
+    /**
+     * @brief tick Called by the TickScheduler when the behavior is due. The behaviors of an object
+     * get one tick after it is placed in a GameObjectModel, the ones that do not need ticks stop there.
+     * @return The number of ticks until the next call, 0 to stop getting ticks.
+     */
+    virtual int tick() {
+        return 0;
+    };
+
+    /**
+     * @brief isScheduled Checks if the behavior is waiting for a tick.
+     */
+    bool isScheduled() const {
+        return m_nextTick >= 0;
+    }
+
+    /**
+     * @brief isShared Checks if the behavior is a flyweight used by many GameObjects, made without an owner.
+     */
+    bool isShared() const {
+        return m_shared;
+    }
+
+    /**
+     * @brief shared Gets the shared instance of a behavior, made the first time it is asked for.
+     * Only for behaviors that keep nothing but their owner, which they then get on every call.
+     * @return The behavior, the same one every time.
+     */
+    template <typename T>
+    static QSharedPointer<T> shared() {
+        static const QSharedPointer<T> instance = QSharedPointer<T>::create(nullptr);
+        return instance;
+    }
+
 protected:
+    /**
+     * @brief wake Schedules this behavior in the TickScheduler of the level of its owner.
+     * Does nothing if it is already due sooner or the owner is not in a level.
+     * @param delay The number of ticks until tick() is called.
+     */
+    void wake(int delay = 1);
+
     /**
      * @brief m_owner the GameObject this behavior belongs to.
      */
     QPointer<GameObject> m_owner;
+
+private:
+    /**
+     * @brief m_shared True for flyweights, they have no owner.
+     */
+    const bool m_shared;
+    friend class TickScheduler;
+    /**
+     * @brief m_nextTick The tick of the scheduler this behavior is due on, -1 if it is not scheduled.
+     */
+    qint64 m_nextTick = -1;
 };
 #endif // BEHAVIOR_H
@@ -3,7 +3,7 @@
 int CounterAttackBehavior::getAttacked(const QPointer<GameObject> &target, int strenght) {
     // This is neat, the opposite angle is the angle + 180,
     // modulo 360 makes sure it is always smaller than 360 deg.
-    int direction = target->getData(DataRole::Direction).toInt();
+    int direction = static_cast<int>(target->get<DataRole::Direction>());
     int newDirection = (180 + direction) % 360;
 
     // Move to where you got attacked and counter attack.
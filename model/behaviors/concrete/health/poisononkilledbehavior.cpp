@@ -2,52 +2,49 @@
 #include "model/behaviors/attack.h"
 #include "model/behaviors/poison.h"
 
-#include <QRandomGenerator>
+#include "model/gamerandom.h"
 
 #include <model/behaviors/concrete/movement/genericwalkablebehavior.h>
 
 void PoisonOnKilledBehavior::die() {
     // Make object inert
     m_owner->removeBehavior<Attack>();
-    m_owner->setBehavior<Movement>(QSharedPointer<GenericWalkableBehavior>::create(m_owner));
+    m_owner->setBehavior<Movement>(Behavior::shared<GenericWalkableBehavior>());
 
     // Calculate the times to spread poison (the tile offset will be based on this)
-    m_count = m_poisonTimes = QRandomGenerator::global()->bounded(
+    m_count = m_poisonTimes = GameRandom::global().bounded(
       Poison::SETTINGS::POISON_SPREAD_TIMES_MIN,
       Poison::SETTINGS::POISON_SPREAD_TIMES_MAX);
 
-    // Calculate the poisoning ticks.
-    m_nextPoison = QRandomGenerator::global()->bounded(
+    // The first spread is a random amount of ticks after the death.
+    wake(GameRandom::global().bounded(
       Poison::SETTINGS::POISON_SPREAD_MIN_TICKS,
-      Poison::SETTINGS::POISON_SPREAD_MAX_TICKS);
-
-    connect(m_owner, &GameObject::tick, this, &PoisonOnKilledBehavior::spreadPoison);
+      Poison::SETTINGS::POISON_SPREAD_MAX_TICKS));
 }
 
-void PoisonOnKilledBehavior::spreadPoison() {
-    m_tickCount++;
-
-    if(m_nextPoison > m_tickCount) {
-        return;
+int PoisonOnKilledBehavior::tick() {
+    // Still alive, this is the first tick after it was placed.
+    if(!m_poisonTimes) {
+        return 0;
     }
 
     // Poison all neighbors until the count is up. Then delete object.
     if(m_count) {
-        m_tickCount = 0;
-        m_nextPoison = QRandomGenerator::global()->bounded(
-          Poison::SETTINGS::POISON_SPREAD_MIN_TICKS,
-          Poison::SETTINGS::POISON_SPREAD_MAX_TICKS);
-
         for(const auto &n : m_owner->getAllNeighbors(m_poisonTimes - m_count)) {
             if(n) {
-                m_owner->getBehavior<Poison>()->poison(n);
+                m_owner->getBehavior<Poison>()->poison(m_owner, n);
             }
         }
 
         m_count--;
-    } else {
-        m_owner->setData(DataRole::Destroyed, true);
-        // Could also call the die function in health...
-        delete m_owner;
+        return GameRandom::global().bounded(
+          Poison::SETTINGS::POISON_SPREAD_MIN_TICKS,
+          Poison::SETTINGS::POISON_SPREAD_MAX_TICKS);
     }
+
+    m_owner->setData(DataRole::Destroyed, true);
+    // Could also call the die function in health...
+    // The scheduler still holds this behavior, so it outlives its owner until the tick is over.
+    delete m_owner;
+    return 0;
 }
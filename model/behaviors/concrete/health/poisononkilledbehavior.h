@@ -24,17 +24,16 @@ public:
      */
     void die() override;
 
-private:
-    // Variables to handle current poisoning state.
-    unsigned int m_nextPoison = 0, m_poisonTimes = 0, m_tickCount = 0, m_count;
-
-public slots:
     /**
-     * @brief spreadPoison main slot to handle the spreading of the poison.
-     * It will spread poison to a random amount of neigbors + offset after a random
-     * amount of ticks.
+     * @brief tick spreads the poison to a random amount of neigbors + offset and then
+     * waits a random amount of ticks, the owner is deleted once the count is up.
+     * @return The ticks until the next spread, 0 when the owner is gone.
      */
-    void spreadPoison();
+    int tick() override;
+
+private:
+    // Variables to handle current poisoning state.
+    unsigned int m_poisonTimes = 0, m_count = 0;
 };
 
 #endif // POISONONKILLEDBEHAVIOR_H
@@ -1,28 +1,23 @@
 #include "genericmovebehavior.h"
 
 bool GenericMoveBehavior::stepOn(QPointer<GameObject> target) {
-    // Get all the behaviors from the target and its children.
-    auto behaviors = target->getAllBehaviors<Movement>();
+    // Go through the behaviors of the target and its children.
     bool steppable = true;
-
-    for(const auto &bh : behaviors) {
-        if(bh.isNull())
-            return false;
-
-        steppable = steppable && bh->isSteppable();
-    }
+    target->forEachBehavior<Movement>([&steppable](GameObject *, const QSharedPointer<Movement> &bh) {
+        steppable = steppable && !bh.isNull() && bh->isSteppable();
+    });
 
     // if any of them is not steppable or don't have the movement behavior, don't move.
     if(!steppable)
         return false;
 
-    float energy = m_owner->getData(DataRole::Energy).toFloat();
-    float targetEnergy = target->getData(DataRole::Energy).toFloat();
+    float energy = m_owner->get<DataRole::Energy>();
+    float targetEnergy = target->get<DataRole::Energy>();
 
     // Makes sure the protagonist does not get stuck even if they have a bit of energy left.
     if(energy - targetEnergy < 0) {
         for(const auto &neighbor : m_owner->getAllNeighbors()) {
-            if(neighbor->getData(DataRole::Energy).toFloat())
+            if(neighbor->get<DataRole::Energy>())
                 break;
             m_owner->setData(DataRole::Energy, 0);
         }
@@ -30,9 +25,9 @@ bool GenericMoveBehavior::stepOn(QPointer<GameObject> target) {
     }
 
     // Call step on all the children from the target (and the target itself).
-    for(const auto &bh : behaviors) {
-        bh->getSteppedOn(m_owner);
-    }
+    target->forEachBehavior<Movement>([this](GameObject *object, const QSharedPointer<Movement> &bh) {
+        bh->getSteppedOn(object, m_owner);
+    });
 
     m_owner->setParent(target);
     // This event is the Qt way of notifying a parent change, the view is unaware of
@@ -47,7 +42,7 @@ bool GenericMoveBehavior::stepOn(QPointer<GameObject> target) {
 
 bool GenericMoveBehavior::stepOn(Direction direction) {
     // You can either turn or move in the direction you are looking, not both
-    auto currentDirection = m_owner->getData(DataRole::Direction).value<Direction>();
+    auto currentDirection = m_owner->get<DataRole::Direction>();
     if(direction != currentDirection) {
         m_owner->setData(DataRole::Direction, QVariant::fromValue<Direction>(direction));
         return false;
@@ -2,7 +2,7 @@
 
 #include <model/behaviors/health.h>
 
-bool HealOnStepBehavior::getSteppedOn(const QPointer<GameObject> &source) {
-    m_owner->getBehavior<Health>()->heal(source);
-    return GenericWalkableBehavior::getSteppedOn(source);
+bool HealOnStepBehavior::getSteppedOn(GameObject *owner, const QPointer<GameObject> &source) {
+    owner->getBehavior<Health>()->heal(source);
+    return GenericWalkableBehavior::getSteppedOn(owner, source);
 }
@@ -19,10 +19,11 @@ public:
 public:
     /**
      * @brief getSteppedOn call the heal method from the owner's health behavior on source.
+     * @param owner the object stepped on.
      * @param source the object stepping on the owner.
      * @return result of GenericWalkableBehavior::getSteppedOn (true)
      */
-    bool getSteppedOn(const QPointer<GameObject> &source) override;
+    bool getSteppedOn(GameObject *owner, const QPointer<GameObject> &source) override;
 };
 
 #endif // HEALONSTEPBEHAVIOR_H
@@ -17,10 +17,11 @@ public:
     NewLevelOnStep() = delete;
     /**
      * @brief getSteppedOn if the object stepping on the owner is a protagonist, go to a new level.
+     * @param owner the object stepped on.
      * @param source the object stepping on the owner.
      * @return true
      */
-    bool getSteppedOn(const QPointer<GameObject> &source) override;
+    bool getSteppedOn(GameObject *owner, const QPointer<GameObject> &source) override;
 };
 
 #endif // NEWLEVELONSTEP_H
@@ -19,10 +19,11 @@ public:
 public:
     /**
      * @brief getSteppedOn overrides the default walkable function and poisons if the owner has any.
+     * @param owner the object stepped on.
      * @param source object stepping on the owner.
      * @return result of GenericWalkableBehavior::getSteppedOn
      */
-    bool getSteppedOn(const QPointer<GameObject> &source) override;
+    bool getSteppedOn(GameObject *owner, const QPointer<GameObject> &source) override;
 };
 
 #endif // POISONONSTEPBEHAVIOR_H
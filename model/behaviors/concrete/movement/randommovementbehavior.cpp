@@ -1,8 +1,8 @@
 #include "randommovementbehavior.h"
 
-#include <QRandomGenerator>
+#include "model/gamerandom.h"
 
-void RandomMovementBehavior::moveRandomly() {
+int RandomMovementBehavior::tick() {
     bool steppable = true;
     float energy = 0;
     for(const auto &neighbor : m_owner->getAllNeighbors()) {
@@ -16,11 +16,11 @@ void RandomMovementBehavior::moveRandomly() {
         // Check if there is a protagonist in the neigbor. TODO: Put this in the game object.
         for(const auto &data : neighbor->getAllData()) {
             if(data[DataRole::Type].value<ObjectType>() == ObjectType::Protagonist) {
-                return;
+                return 1;
             }
         }
         // Get the energy of the tile around it, if it is infinite, make it very big.
-        float neighborEnergy = neighbor->getData(DataRole::Energy).toFloat();
+        float neighborEnergy = neighbor->get<DataRole::Energy>();
         neighborEnergy = neighborEnergy == INFINITY ? 1000000000 : neighborEnergy;
 
         // Save the biggest energy of all neighbors.
@@ -29,10 +29,9 @@ void RandomMovementBehavior::moveRandomly() {
 
     // If no neigbors are steppable or the energy is lower than the highest neighbor stop moving.
     // Enemies should have large energies, I don't like it that much when they stop moving.
-    if(!steppable || energy > m_owner->getData(DataRole::Energy).toFloat()) {
+    if(!steppable || energy > m_owner->get<DataRole::Energy>()) {
         m_owner->setData(DataRole::Energy, 0);
-        disconnect(m_owner, &GameObject::tick, this, &RandomMovementBehavior::moveRandomly);
-        return;
+        return 0;
     }
 
     // Declares a uniform distribution from 0 to 7. Much more natural looking than the default
@@ -40,13 +39,14 @@ void RandomMovementBehavior::moveRandomly() {
     std::uniform_int_distribution<> dist(0, 7);
     int direction, count = 0;
     do {
-        // Ensure it is uniquely seeded by using the global static method of QRandomGenerator.
-        direction = dist(*QRandomGenerator::global()) * 45;
+        // The generator of the game, so a loaded game moves the enemies like the saved one would have.
+        direction = dist(GameRandom::global().engine()) * 45;
 
         // If it can't move it is probably stuck, exit.
         if(count > 7) {
-            return;
+            return 1;
         }
         count++;
     } while(!GenericMoveBehavior::stepOn(static_cast<Direction>(direction)));
+    return 1;
 }
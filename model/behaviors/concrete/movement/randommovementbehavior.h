@@ -11,22 +11,20 @@ class RandomMovementBehavior : public QObject, public GenericMoveBehavior {
     Q_OBJECT
 public:
     /**
-     * @brief RandomMovementBehavior connects the owner's tick to the moveRandomly function
+     * @brief RandomMovementBehavior constructor, the owner starts moving on the first tick after it is placed.
      * @param owner of the behavior
      */
     RandomMovementBehavior(QPointer<GameObject> owner)
-        : GenericMoveBehavior(owner) {
-        connect(owner, &GameObject::tick, this, &RandomMovementBehavior::moveRandomly);
-    };
+        : GenericMoveBehavior(owner) {};
     RandomMovementBehavior() = delete;
 
-public slots:
     /**
-     * @brief moveRandomly make a random movement in a direction.
+     * @brief tick make a random movement in a direction.
      * The directions are all multiples of 45 degrees so the owner can move to
      * all eight neighbors.
+     * @return 1 to move again next tick, 0 once the owner stopped moving for good.
      */
-    void moveRandomly();
+    int tick() override;
 };
 
 #endif // RANDOMMOVEMENTBEHAVIOR_H
@@ -1,12 +1,20 @@
 #include "genericpoisonablebehavior.h"
 #include "model/behaviors/health.h"
 
-void GenericPoisonableBehavior::poisonEffect() {
+int GenericPoisonableBehavior::getPoisoned(GameObject *owner, int level) {
+    int gained = Poison::getPoisoned(owner, level);
+    // Only ticks while poisoned, instead of checking the poison level on every tick.
+    if(gained) {
+        wake();
+    }
+    return gained;
+}
+
+int GenericPoisonableBehavior::tick() {
     QVariant poisonLevel = m_owner->getData(DataRole::PoisonLevel);
     auto behavior = m_owner->getBehavior<Health>();
-    // Probably better not to do this every tick, the player is the only poisonable obj.
     if(!(poisonLevel.isValid() && behavior && poisonLevel.toInt())) {
-        return;
+        return 0;
     }
 
     // It becomes a race against time to see if you can reach a health pack before dying.
@@ -14,8 +22,9 @@ void GenericPoisonableBehavior::poisonEffect() {
     if(newPoison > Settings.MIN_POISON) {
         behavior->getHealthChanged(-Settings.DAMAGE_PER_TICK);
         m_owner->setData(DataRole::PoisonLevel, newPoison);
-
-    } else {
-        m_owner->setData(DataRole::PoisonLevel, 0);
+        return 1;
     }
+
+    m_owner->setData(DataRole::PoisonLevel, 0);
+    return 0;
 }
@@ -13,24 +13,26 @@ class GenericPoisonableBehavior : public QObject, public Poison {
 public:
     /**
      * @brief GenericPoisonableBehavior default constructor.
-     * This behavior connects the tick signal of its owner to its poisonEffect slot.
      * @param owner the owner of the behavior.
      */
     GenericPoisonableBehavior(QPointer<GameObject> owner)
-        : Poison(owner) {
-        // Slightly inefficient to connect and check always if there is poison, but since it is
-        // only used on the protagonist it is fine for now. The getPoisoned function can be
-        // overwritten in this behavior to only connect the slot when it gets poisoned.
-        connect(owner, &GameObject::tick, this, &GenericPoisonableBehavior::poisonEffect);
-    };
+        : Poison(owner) {};
     GenericPoisonableBehavior() = delete;
 
-public slots:
     /**
-     * @brief poisonEffect slot handles the poison effect on the object every tick.
+     * @brief getPoisoned overrides getPoisoned from Poison to start getting ticks once there is poison.
+     * @param owner the object getting poisoned, always the owner since this behavior is not shared.
+     * @param level amount to be poisoned.
+     * @return poison gained by object.
+     */
+    int getPoisoned(GameObject *owner, int level) override;
+
+    /**
+     * @brief tick handles the poison effect on the object every tick.
      * It only affects objects that have both the health behavior and poison levels > 0.
+     * @return 1 while there is poison left, 0 to stop getting ticks.
      */
-    void poisonEffect();
+    int tick() override;
 };
 
 #endif // GENERICPOISONABLEBEHAVIOR_H
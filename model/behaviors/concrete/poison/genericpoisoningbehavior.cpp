@@ -1,28 +1,28 @@
 #include "genericpoisoningbehavior.h"
 
-#include <QRandomGenerator>
+#include "model/gamerandom.h"
 
-int GenericPoisoningBehavior::poison(const QPointer<GameObject> &target) {
-    auto behaviors = target->getAllBehaviors<Poison>();
+int GenericPoisoningBehavior::poison(GameObject *owner, const QPointer<GameObject> &target) {
     int poisonAdminisered = 0;
 
-    for(const auto &behavior : behaviors) {
-        if(behavior) {
-            int currentLevel = m_owner->getData(DataRole::PoisonLevel).toInt();
+    target->forEachBehavior<Poison>([owner, &poisonAdminisered](GameObject *object, const QSharedPointer<Poison> &behavior) {
+        if(!behavior) {
+            return;
+        }
+        int currentLevel = owner->getData(DataRole::PoisonLevel).toInt();
 
-            if(currentLevel <= 0) {
-                continue;
-            }
-            // This makes it more fun, otherwise the player just mops up all the poison in the tiles.
-            int poisonAmount = QRandomGenerator::global()->bounded(
-              Poison::SETTINGS::MIN_POISON_PER_ACTION, Poison::SETTINGS::MAX_POISON_PER_ACTION);
+        if(currentLevel <= 0) {
+            return;
+        }
+        // This makes it more fun, otherwise the player just mops up all the poison in the tiles.
+        int poisonAmount = GameRandom::global().bounded(
+          Poison::SETTINGS::MIN_POISON_PER_ACTION, Poison::SETTINGS::MAX_POISON_PER_ACTION);
 
-            int poisonedAmount = currentLevel > poisonAmount ? poisonAmount : currentLevel;
-            poisonedAmount = behavior->getPoisoned(poisonedAmount);
-            poisonAdminisered += poisonedAmount;
+        int poisonedAmount = currentLevel > poisonAmount ? poisonAmount : currentLevel;
+        poisonedAmount = behavior->getPoisoned(object, poisonedAmount);
+        poisonAdminisered += poisonedAmount;
 
-            m_owner->setData(DataRole::PoisonLevel, QVariant(currentLevel - poisonedAmount));
-        }
-    }
+        owner->setData(DataRole::PoisonLevel, QVariant(currentLevel - poisonedAmount));
+    });
     return poisonAdminisered;
 }
@@ -5,6 +5,7 @@
 
 /**
  * @brief The GenericPoisoningBehavior class handles the poison action from an object.
+ * It keeps no state, so tiles and poison enemies use a shared instance.
  */
 class GenericPoisoningBehavior : public Poison {
 public:
@@ -17,10 +18,11 @@ public:
     GenericPoisoningBehavior() = delete;
     /**
      * @brief poison poison a target while decreasing the poison level.
+     * @param owner the object poisoning.
      * @param target the target to poison.
      * @return the poison level lost.
      */
-    int poison(const QPointer<GameObject> &target) override;
+    int poison(GameObject *owner, const QPointer<GameObject> &target) override;
 };
 
 #endif // GENERICPOISONINGBEHAVIOR_H
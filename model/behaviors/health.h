@@ -13,6 +13,11 @@
  */
 class Health : public Behavior {
 public:
+    /**
+     * @brief SLOT The slot of this interface in a GameObject.
+     */
+    static constexpr BehaviorSlot SLOT = BehaviorSlot::Health;
+
     /**
      * @brief Health default constructor.
      * @param owner the owner of the behavior.
@@ -17,6 +17,11 @@
  */
 class Movement : public Behavior {
 public:
+    /**
+     * @brief SLOT The slot of this interface in a GameObject.
+     */
+    static constexpr BehaviorSlot SLOT = BehaviorSlot::Movement;
+
     /**
      * @brief Movement default constructor.
      * @param owner of the behavior.
@@ -62,10 +67,11 @@ public:
     };
     /**
      * @brief getSeppedOn handles the source stepping on the owner.
+     * @param owner the object stepped on, the owner of the behavior unless it is shared.
      * @param source object stepping on owner.
      * @return false by default.
      */
-    virtual bool getSteppedOn(const QPointer<GameObject> &source) {
+    virtual bool getSteppedOn(GameObject *owner, const QPointer<GameObject> &source) {
         return false;
     };
 };
@@ -1,8 +1,8 @@
 #include "poison.h"
 Poison::~Poison() {};
 
-int Poison::getPoisoned(int level) {
-    QVariant poisonLevel = m_owner->getData(DataRole::PoisonLevel);
+int Poison::getPoisoned(GameObject *owner, int level) {
+    QVariant poisonLevel = owner->getData(DataRole::PoisonLevel);
     if(poisonLevel.isNull()) {
         throw("Cannot change poison level of object.");
     }
@@ -14,7 +14,7 @@ int Poison::getPoisoned(int level) {
         newPoison = Settings.MAX_POISON;
     }
 
-    m_owner->setData(DataRole::PoisonLevel, QVariant(newPoison));
+    owner->setData(DataRole::PoisonLevel, QVariant(newPoison));
 
     return newPoison - poisonLevel.toInt();
 }
@@ -11,6 +11,11 @@
  */
 class Poison : public Behavior {
 public:
+    /**
+     * @brief SLOT The slot of this interface in a GameObject.
+     */
+    static constexpr BehaviorSlot SLOT = BehaviorSlot::Poison;
+
     /**
      * @brief Poison Default constructor
      * @param owner of the behavior
@@ -61,19 +66,21 @@ public:
 
     /**
      * @brief poison poison a target.
+     * @param owner the object poisoning, the owner of the behavior unless it is shared.
      * @param target target to be poisoned.
      * @return poison amount.
      */
-    virtual int poison(const QPointer<GameObject> &target) {
+    virtual int poison(GameObject *owner, const QPointer<GameObject> &target) {
         return 0;
     };
     /**
      * @brief getPoisoned get poisoned a ceirtain amount.
+     * @param owner the object getting poisoned, the owner of the behavior unless it is shared.
      * @param level amount to be poisoned.
      * @return poison gained by object.
      * Poison gained can be lower than level since there is a MAX_POISON level.
      */
-    virtual int getPoisoned(int level);
+    virtual int getPoisoned(GameObject *owner, int level);
 };
 
 #endif // POISON_H
@@ -0,0 +1,67 @@
+#include "changejournal.h"
+#include "gameobject.h"
+
+void ChangeJournal::record(const GameObject *object, DataRole role, const QVariant &oldValue,
+                           const QVariant &newValue, QPoint position, Direction direction) {
+    Entry entry {object, role, oldValue, newValue, position, direction};
+    auto key = qMakePair(object, (int)role);
+    if(auto it = m_latest.find(key); it != m_latest.end()) {
+        // The newest entry goes to the end so it is applied after any move in between.
+        auto &previous = m_entries[*it];
+        previous.replaced = true;
+        entry.oldValue = previous.oldValue;
+        // A move keeps the direction of the object.
+        if(role != DataRole::Position && entry.oldValue != newValue) {
+            entry.direction = newValue.toFloat() > entry.oldValue.toFloat() ? Direction::Up : Direction::Down;
+        }
+    }
+    m_latest.insert(key, m_entries.size());
+    m_entries.append(entry);
+}
+
+void ChangeJournal::forget(const GameObject *object) {
+    int snapshot = -1;
+    for(auto &entry : m_entries) {
+        if(entry.object != object || entry.snapshot != -1) {
+            continue;
+        }
+        if(snapshot == -1) {
+            snapshot = m_snapshots.size();
+            m_snapshots.append(object->getData());
+        }
+        entry.snapshot = snapshot;
+    }
+
+    // A new object could get the same address, its changes are not the same as these.
+    auto it = m_latest.begin();
+    while(it != m_latest.end()) {
+        if(it.key().first == object) {
+            it = m_latest.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+QList<QMap<DataRole, QVariant>> ChangeJournal::take() {
+    QList<QMap<DataRole, QVariant>> batch;
+    batch.reserve(m_entries.size());
+    for(const auto &entry : m_entries) {
+        if(entry.replaced) {
+            continue;
+        }
+
+        auto data = entry.snapshot == -1 ? entry.object->getData() : m_snapshots[entry.snapshot];
+        data[DataRole::Position] = entry.position;
+        data[entry.role] = entry.newValue;
+        // These data roles are never stored in the GameObjects
+        data[DataRole::LatestChange] = QVariant::fromValue<DataRole>(entry.role);
+        data[DataRole::ChangeDirection] = QVariant::fromValue<Direction>(entry.direction);
+        batch.append(data);
+    }
+
+    m_entries.clear();
+    m_latest.clear();
+    m_snapshots.clear();
+    return batch;
+}
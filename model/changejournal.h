@@ -0,0 +1,89 @@
+#ifndef CHANGEJOURNAL_H
+#define CHANGEJOURNAL_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QPoint>
+#include <QVariant>
+
+#include "publicenums.h"
+
+// Foward declaration of GameObject
+class GameObject;
+
+/**
+ * @brief The ChangeJournal class records the data changes of the GameObjects of a level during a tick,
+ * so they can be delivered to the view and the controller in one batch instead of one signal per setData.
+ * Every change is a small entry (object, role, old value, new value, position of the object).
+ * Changes to the same role of the same object are coalesced: only the newest value is kept and the
+ * change direction goes from the first old value to the last new one. Several moves become one move
+ * to the last tile, the view finds the item by its id.
+ * The full data of an object is only read once, when the batch is taken, or when the object is destroyed.
+ */
+class ChangeJournal {
+public:
+    /**
+     * @brief record Adds a change to the journal.
+     * @param object The object that changed.
+     * @param role The role that changed.
+     * @param oldValue The value before the change.
+     * @param newValue The value after the change.
+     * @param position The position of the object (the tile it is on).
+     * @param direction The direction of the change, for moves the direction of the object.
+     */
+    void record(const GameObject *object, DataRole role, const QVariant &oldValue, const QVariant &newValue,
+                QPoint position, Direction direction);
+
+    /**
+     * @brief forget Called when an object is destroyed, keeps a copy of its data for the changes that are still pending.
+     * @param object The object that is being destroyed.
+     */
+    void forget(const GameObject *object);
+
+    /**
+     * @brief isEmpty Checks if there are changes to deliver.
+     */
+    bool isEmpty() const {
+        return m_entries.isEmpty();
+    }
+
+    /**
+     * @brief take Builds the batch of changes and clears the journal.
+     * @return One data map per change, in the same format GameObject::dataChanged used to emit:
+     * the data of the object with the Position, LatestChange and ChangeDirection of that change.
+     */
+    QList<QMap<DataRole, QVariant>> take();
+
+private:
+    /**
+     * @brief The Entry struct, one recorded change.
+     */
+    struct Entry {
+        const GameObject *object;
+        DataRole role;
+        QVariant oldValue;
+        QVariant newValue;
+        QPoint position;
+        Direction direction;
+        /// Index in m_snapshots once the object is destroyed, -1 while it is alive.
+        int snapshot = -1;
+        /// Set when a newer entry for the same object and role replaced this one.
+        bool replaced = false;
+    };
+
+    /**
+     * @brief m_entries The changes in the order they happened.
+     */
+    QList<Entry> m_entries;
+    /**
+     * @brief m_latest The index of the newest entry of each object and role, used to coalesce.
+     */
+    QHash<QPair<const GameObject *, int>, int> m_latest;
+    /**
+     * @brief m_snapshots The data of the objects destroyed while they had pending changes.
+     */
+    QList<QMap<DataRole, QVariant>> m_snapshots;
+};
+
+#endif // CHANGEJOURNAL_H
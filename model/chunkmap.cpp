@@ -0,0 +1,24 @@
+#include "chunkmap.h"
+
+#include <cstdlib>
+
+ChunkMap::ChunkMap(int columns, int rows)
+    : m_columns(columns)
+    , m_rows(rows)
+    , m_chunkColumns((columns + SETTINGS::CHUNK_SIZE - 1) / SETTINGS::CHUNK_SIZE)
+    , m_chunkRows((rows + SETTINGS::CHUNK_SIZE - 1) / SETTINGS::CHUNK_SIZE)
+    , m_streamed(columns * rows >= SETTINGS::MIN_STREAMED_CELLS)
+    , m_chunks(m_chunkColumns * m_chunkRows) {
+}
+
+QRect ChunkMap::area(int chunk) const {
+    int x = (chunk / m_chunkRows) * SETTINGS::CHUNK_SIZE;
+    int y = (chunk % m_chunkRows) * SETTINGS::CHUNK_SIZE;
+    return QRect(x, y, qMin(SETTINGS::CHUNK_SIZE, m_columns - x), qMin(SETTINGS::CHUNK_SIZE, m_rows - y));
+}
+
+int ChunkMap::distance(int chunk, int other) const {
+    int dx = std::abs(chunk / m_chunkRows - other / m_chunkRows);
+    int dy = std::abs(chunk % m_chunkRows - other % m_chunkRows);
+    return qMax(dx, dy);
+}
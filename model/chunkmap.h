@@ -0,0 +1,148 @@
+#ifndef CHUNKMAP_H
+#define CHUNKMAP_H
+
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <vector>
+
+#include "model/objectdata.h"
+
+/**
+ * @brief The ChunkMap class splits a level into square chunks of CHUNK_SIZE tiles and keeps track of which
+ * chunks have GameObjects. A chunk is either materialized, its tiles and the objects on them are GameObjects,
+ * or cold, its tiles only exist in the WorldGrid and its objects are packed here as their data.
+ * The occupant masks of the grid do not change when a chunk goes cold, so nearest() and the distance fields
+ * still see the packed objects. The GameObjectModel does the materializing, this class only does the bookkeeping.
+ */
+class ChunkMap {
+public:
+    /// Chunk settings
+    static const struct SETTINGS {
+        /// The width and height of a chunk in tiles.
+        static constexpr int CHUNK_SIZE = 64;
+        /// Levels with fewer tiles are materialized completely and never go cold.
+        static constexpr int MIN_STREAMED_CELLS = 256 * 256;
+        /// The chunks up to this many chunks away from the protagonist are always materialized.
+        static constexpr int HOT_RADIUS = 1;
+        /// The number of ticks between two updates of the chunks, and the least a chunk stays materialized.
+        static constexpr int UPDATE_TICKS = 16;
+    } Settings;
+
+    /**
+     * @brief The PackedObject struct is an object standing on a tile of a cold chunk.
+     */
+    struct PackedObject {
+        /// The location of the tile
+        QPoint position;
+        /// The data of the object
+        ObjectData data;
+    };
+
+    /**
+     * @brief ChunkMap constructor, all the chunks start cold.
+     * @param columns The number of columns of the level.
+     * @param rows The number of rows of the level.
+     */
+    ChunkMap(int columns, int rows);
+
+    /**
+     * @brief isStreamed Checks if chunks go cold again, false for small levels which are kept materialized.
+     */
+    bool isStreamed() const {
+        return m_streamed;
+    }
+
+    /**
+     * @brief count The number of chunks.
+     */
+    int count() const {
+        return m_chunkColumns * m_chunkRows;
+    }
+
+    /**
+     * @brief chunkOf The chunk of a tile.
+     */
+    int chunkOf(int x, int y) const {
+        return (x / SETTINGS::CHUNK_SIZE) * m_chunkRows + y / SETTINGS::CHUNK_SIZE;
+    }
+
+    /**
+     * @brief area The tiles of a chunk, the chunks on the right and bottom border can be smaller.
+     */
+    QRect area(int chunk) const;
+
+    /**
+     * @brief distance The distance in chunks (Chebyshev) between two chunks.
+     */
+    int distance(int chunk, int other) const;
+
+    /**
+     * @brief isMaterialized Checks if the tiles of a chunk are GameObjects.
+     */
+    bool isMaterialized(int chunk) const {
+        return m_chunks[chunk].materializedAt >= 0;
+    }
+
+    /**
+     * @brief setMaterialized Marks a chunk as materialized or cold.
+     * @param chunk The chunk.
+     * @param tick The tick it was materialized on, -1 to mark it cold.
+     */
+    void setMaterialized(int chunk, qint64 tick) {
+        m_chunks[chunk].materializedAt = tick;
+    }
+
+    /**
+     * @brief materializedAt The tick a chunk was materialized on, -1 if it is cold.
+     */
+    qint64 materializedAt(int chunk) const {
+        return m_chunks[chunk].materializedAt;
+    }
+
+    /**
+     * @brief objects The packed objects of a cold chunk.
+     */
+    QList<PackedObject> &objects(int chunk) {
+        return m_chunks[chunk].objects;
+    }
+
+    /**
+     * @brief objects The packed objects of a cold chunk.
+     */
+    const QList<PackedObject> &objects(int chunk) const {
+        return m_chunks[chunk].objects;
+    }
+
+private:
+    /**
+     * @brief The Chunk struct is the state of one chunk.
+     */
+    struct Chunk {
+        /// The tick the chunk was materialized on, -1 while it is cold
+        qint64 materializedAt = -1;
+        /// The objects of the chunk while it is cold
+        QList<PackedObject> objects;
+    };
+
+    /**
+     * @brief m_columns, m_rows The size of the level in tiles.
+     */
+    int m_columns;
+    int m_rows;
+    /**
+     * @brief m_chunkColumns, m_chunkRows The size of the level in chunks.
+     */
+    int m_chunkColumns;
+    int m_chunkRows;
+    /**
+     * @brief m_streamed True if chunks go cold again.
+     */
+    bool m_streamed;
+    /**
+     * @brief m_chunks The state of every chunk, index chunkOf().
+     */
+    std::vector<Chunk> m_chunks;
+};
+
+#endif // CHUNKMAP_H
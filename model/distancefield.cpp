@@ -0,0 +1,223 @@
+#include "distancefield.h"
+
+#include <cmath>
+#include <queue>
+
+namespace {
+    /**
+     * @brief forEachNeighbor Calls f with the index of each of the 8 neighbors of a cell that are inside the grid.
+     */
+    template <typename F>
+    void forEachNeighbor(const WorldGrid &grid, int index, F f) {
+        QPoint pos = grid.position(index);
+        for(int dx = -1; dx <= 1; ++dx) {
+            for(int dy = -1; dy <= 1; ++dy) {
+                if((dx || dy) && grid.contains(pos.x() + dx, pos.y() + dy)) {
+                    f(grid.index(pos.x() + dx, pos.y() + dy));
+                }
+            }
+        }
+    }
+}
+
+DistanceField::DistanceField(WorldGrid *grid, quint8 sourceMask)
+    : m_grid(grid)
+    , m_mask(sourceMask) {
+    m_grid->addObserver(this);
+}
+
+DistanceField::~DistanceField() {
+    m_grid->removeObserver(this);
+}
+
+void DistanceField::addSource(int index) {
+    if(m_extraSources.contains(index)) {
+        return;
+    }
+    m_extraSources.append(index);
+    if(m_built) {
+        m_dirtySources.append(index);
+    }
+}
+
+void DistanceField::removeSource(int index) {
+    if(m_extraSources.removeOne(index) && m_built) {
+        m_dirtySources.append(index);
+    }
+}
+
+float DistanceField::distance(int index) {
+    update();
+    return m_distance[index];
+}
+
+int DistanceField::nextStep(int index) {
+    update();
+    return m_next[index];
+}
+
+std::vector<int> DistanceField::path(int index) {
+    // Same encoding as PathFinder::A_star, the direction of a move is 45 * move + 90.
+    static constexpr int MOVES[3][3] = {
+      {1, 0, 7}, // dy = -1: TopLeft, Up, TopRight
+      {2, -1, 6}, // dy = 0: Left, -, Right
+      {3, 4, 5}, // dy = 1: BottomLeft, Down, BottomRight
+    };
+
+    update();
+    std::vector<int> moves;
+    if(!std::isfinite(m_distance[index])) {
+        return moves;
+    }
+
+    for(int current = index, next = m_next[index]; next != -1 && (int)moves.size() < m_grid->size();
+        current = next, next = m_next[next]) {
+        QPoint step = m_grid->position(next) - m_grid->position(current);
+        moves.push_back(MOVES[step.y() + 1][step.x() + 1]);
+    }
+    return moves;
+}
+
+void DistanceField::occupantsChanged(int index, quint8 oldMask, quint8 newMask) {
+    if(m_built && ((oldMask ^ newMask) & m_mask)) {
+        m_dirtySources.append(index);
+    }
+}
+
+void DistanceField::costChanged(int index) {
+    if(m_built) {
+        m_dirtyCosts.append(index);
+    }
+}
+
+float DistanceField::cost(int index) const {
+    float energy = m_grid->get<DataRole::Energy>(index);
+    if(!std::isfinite(energy)) {
+        return INFINITY;
+    }
+    return energy + SETTINGS::STEP_COST + m_grid->get<DataRole::PoisonLevel>(index) * SETTINGS::POISON_COST;
+}
+
+bool DistanceField::isSource(int index) const {
+    return (m_grid->occupants(index) & m_mask) || m_extraSources.contains(index);
+}
+
+void DistanceField::update() {
+    QList<int> seeds;
+    if(!m_built) {
+        m_distance.assign(m_grid->size(), INFINITY);
+        m_next.assign(m_grid->size(), -1);
+        m_source.assign(m_grid->size(), false);
+        for(int index = 0; index < m_grid->size(); ++index) {
+            if(isSource(index)) {
+                m_source[index] = true;
+                m_distance[index] = 0;
+                seeds.append(index);
+            }
+        }
+        m_built = true;
+        m_dirtySources.clear();
+        m_dirtyCosts.clear();
+        propagate(seeds);
+        return;
+    }
+
+    if(m_dirtySources.isEmpty() && m_dirtyCosts.isEmpty()) {
+        return;
+    }
+
+    QList<int> region;
+    // A source that is gone takes its whole tree with it, a new one starts at 0.
+    // Sources never have a next cell, so they are never part of an invalidated tree.
+    for(int index : m_dirtySources) {
+        bool source = isSource(index);
+        if(source == m_source[index]) {
+            continue;
+        }
+        m_source[index] = source;
+        if(source) {
+            m_distance[index] = 0;
+            m_next[index] = -1;
+            seeds.append(index);
+        } else {
+            invalidate(index, true, region);
+        }
+    }
+
+    // The paths that enter a tile whose cost changed are recomputed, in case it got more expensive.
+    // The tile is also a seed, in case it got cheaper.
+    for(int index : m_dirtyCosts) {
+        invalidate(index, false, region);
+        if(std::isfinite(m_distance[index])) {
+            seeds.append(index);
+        }
+    }
+
+    // The invalidated cells start from their best neighbor, the propagation fixes the rest.
+    for(int index : region) {
+        forEachNeighbor(*m_grid, index, [this, index](int neighbor) {
+            float distance = m_distance[neighbor] + cost(neighbor);
+            if(distance < m_distance[index]) {
+                m_distance[index] = distance;
+                m_next[index] = neighbor;
+            }
+        });
+        if(std::isfinite(m_distance[index])) {
+            seeds.append(index);
+        }
+    }
+
+    m_dirtySources.clear();
+    m_dirtyCosts.clear();
+    propagate(seeds);
+}
+
+void DistanceField::invalidate(int root, bool includeRoot, QList<int> &region) {
+    if(includeRoot) {
+        m_distance[root] = INFINITY;
+        m_next[root] = -1;
+        region.append(root);
+    }
+
+    QList<int> stack {root};
+    while(!stack.isEmpty()) {
+        int current = stack.takeLast();
+        forEachNeighbor(*m_grid, current, [&](int neighbor) {
+            if(m_next[neighbor] == current) {
+                m_distance[neighbor] = INFINITY;
+                m_next[neighbor] = -1;
+                region.append(neighbor);
+                stack.append(neighbor);
+            }
+        });
+    }
+}
+
+void DistanceField::propagate(const QList<int> &seeds) {
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for(int index : seeds) {
+        queue.emplace(m_distance[index], index);
+    }
+
+    while(!queue.empty()) {
+        auto [distance, current] = queue.top();
+        queue.pop();
+        if(distance > m_distance[current]) {
+            continue;
+        }
+
+        // Walking from a neighbor onto this tile costs the tile.
+        float through = distance + cost(current);
+        if(!std::isfinite(through)) {
+            continue;
+        }
+        forEachNeighbor(*m_grid, current, [&](int neighbor) {
+            if(through < m_distance[neighbor]) {
+                m_distance[neighbor] = through;
+                m_next[neighbor] = current;
+                queue.emplace(through, neighbor);
+            }
+        });
+    }
+}
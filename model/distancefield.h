@@ -0,0 +1,165 @@
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include <QList>
+#include <vector>
+
+#include "publicenums.h"
+#include "model/worldgrid.h"
+
+/**
+ * @brief The DistanceField class is a Dijkstra map of a level: for every tile it keeps the energy it costs to reach
+ * the closest source and the next tile on the way there. The sources are the tiles with an occupant in the mask
+ * (every enemy, every health pack) plus the ones added by hand (the exit door).
+ * Moving onto a tile costs its energy, a small step cost and a share of its poison, tiles without a finite energy are walls.
+ * The field follows the grid as a GridObserver. Changes are only queued and are applied in one batch on the next query:
+ * a source that is gone or a tile that got more expensive invalidates the tiles whose path went through it,
+ * and only those are recomputed. New sources and cheaper tiles are propagated outwards from where they changed.
+ * The arrays are only allocated on the first query, so levels that are never auto played do not pay for them.
+ */
+class DistanceField : public GridObserver {
+public:
+    /**
+     * @brief The Target enum, the kinds of fields a GameObjectModel has.
+     */
+    enum class Target {
+        Enemies,
+        HealthPacks,
+        Exit,
+    };
+
+    /// Distance field settings
+    static const struct SETTINGS {
+        /// Cost of every step, so zero energy tiles still have a distance
+        static constexpr float STEP_COST = 0.01f;
+        /// Cost per poison level of a tile
+        static constexpr float POISON_COST = 0.01f;
+    } Settings;
+
+    /**
+     * @brief DistanceField constructor, registers the field as observer of the grid.
+     * @param grid The grid of the level, has to outlive the field.
+     * @param sourceMask The occupant types that are sources.
+     */
+    DistanceField(WorldGrid *grid, quint8 sourceMask);
+    ~DistanceField() override;
+
+    /**
+     * @brief addSource Adds a source that does not come from the occupant mask.
+     * @param index The cell.
+     */
+    void addSource(int index);
+
+    /**
+     * @brief removeSource Removes a source added with addSource.
+     * @param index The cell.
+     */
+    void removeSource(int index);
+
+    /**
+     * @brief distance The energy it costs to get from a cell to the closest source.
+     * @param index The cell.
+     * @return The cost, infinity if no source can be reached.
+     */
+    float distance(int index);
+
+    /**
+     * @brief distance Overload that takes the location of the tile.
+     */
+    float distance(QPoint location) {
+        return distance(m_grid->index(location.x(), location.y()));
+    }
+
+    /**
+     * @brief nextStep The next cell on the way to the closest source.
+     * @param index The cell.
+     * @return The index of the next cell, -1 on a source or if no source can be reached.
+     */
+    int nextStep(int index);
+
+    /**
+     * @brief path The moves to the closest source, encoded like the pathfinder does (direction = 45 * move + 90).
+     * @param index The cell to start from.
+     * @return The moves, empty if there is no way.
+     */
+    std::vector<int> path(int index);
+
+    /**
+     * @brief path Overload that takes the location of the tile.
+     */
+    std::vector<int> path(QPoint location) {
+        return path(m_grid->index(location.x(), location.y()));
+    }
+
+    void occupantsChanged(int index, quint8 oldMask, quint8 newMask) override;
+    void costChanged(int index) override;
+
+private:
+    /**
+     * @brief cost The cost of moving onto a cell.
+     */
+    float cost(int index) const;
+
+    /**
+     * @brief isSource Checks the current state of a cell in the grid.
+     */
+    bool isSource(int index) const;
+
+    /**
+     * @brief update Applies the queued changes, or builds the whole field the first time.
+     */
+    void update();
+
+    /**
+     * @brief invalidate Resets a cell and every cell whose path goes through it.
+     * @param root The cell to start from.
+     * @param includeRoot False to keep the root itself, when only the cost of entering it changed.
+     * @param region Where the reset cells are added.
+     */
+    void invalidate(int root, bool includeRoot, QList<int> &region);
+
+    /**
+     * @brief propagate Runs Dijkstra from the given cells, their distance has to be set already.
+     * @param seeds The cells to start from.
+     */
+    void propagate(const QList<int> &seeds);
+
+    /**
+     * @brief m_grid The grid of the level.
+     */
+    WorldGrid *m_grid;
+    /**
+     * @brief m_mask The occupant types that are sources.
+     */
+    quint8 m_mask;
+    /**
+     * @brief m_built If the arrays have been built.
+     */
+    bool m_built = false;
+    /**
+     * @brief m_distance The distance of each cell to the closest source.
+     */
+    std::vector<float> m_distance;
+    /**
+     * @brief m_next The next cell on the way to the closest source, -1 for none.
+     */
+    std::vector<int> m_next;
+    /**
+     * @brief m_source If each cell was a source the last time the field was updated.
+     */
+    std::vector<bool> m_source;
+    /**
+     * @brief m_extraSources The sources added with addSource.
+     */
+    QList<int> m_extraSources;
+    /**
+     * @brief m_dirtySources Cells that might have become or stopped being a source.
+     */
+    QList<int> m_dirtySources;
+    /**
+     * @brief m_dirtyCosts Cells whose cost changed.
+     */
+    QList<int> m_dirtyCosts;
+};
+
+#endif // DISTANCEFIELD_H
@@ -0,0 +1,29 @@
+#include "entityregistry.h"
+
+quint32 EntityRegistry::create() {
+    int slot;
+    if(!m_free.isEmpty()) {
+        slot = m_free.takeLast();
+    } else {
+        slot = m_generations.size();
+        // The slot would run into the generation bits and the id into another object, even in a release build.
+        if(slot >= (1 << INDEX_BITS)) {
+            qFatal("EntityRegistry: more than %d objects in a level", 1 << INDEX_BITS);
+        }
+        // Generations start at 1, so no id is 0.
+        m_generations.append(1);
+    }
+    return (m_generations[slot] << INDEX_BITS) | slot;
+}
+
+void EntityRegistry::release(quint32 id) {
+    if(!isAlive(id)) {
+        return;
+    }
+
+    int slot = index(id);
+    // The generation wraps around but skips 0.
+    quint32 next = (m_generations[slot] + 1) & ((1u << (32 - INDEX_BITS)) - 1);
+    m_generations[slot] = next ? next : 1;
+    m_free.append(slot);
+}
@@ -0,0 +1,67 @@
+#ifndef ENTITYREGISTRY_H
+#define ENTITYREGISTRY_H
+
+#include <QList>
+#include <QtGlobal>
+
+/**
+ * @brief The EntityRegistry class hands out the ids of the GameObjects of a level (DataRole::Id).
+ * An id is a slot index in the low INDEX_BITS bits and the generation of the slot in the others.
+ * The slots of destroyed objects are reused, with a new generation, so the ids stay compact and
+ * whoever keeps a table indexed by slot (the view) can tell an old id from the new object in that slot.
+ * Id 0 is never used, it means no object.
+ */
+class EntityRegistry {
+public:
+    /**
+     * @brief INDEX_BITS The bits of the slot index in an id. The biggest level, 2000x2000, has a little over 4 million objects,
+     * 24 bits leave room for four times that and 8 bits of generation.
+     */
+    static constexpr int INDEX_BITS = 24;
+
+    /**
+     * @brief create Makes a new id, reusing a free slot if there is one.
+     * @return The id.
+     */
+    quint32 create();
+
+    /**
+     * @brief release Frees the slot of an id, the id is no longer alive.
+     * @param id The id to release.
+     */
+    void release(quint32 id);
+
+    /**
+     * @brief isAlive Checks if an id still belongs to an object.
+     */
+    bool isAlive(quint32 id) const {
+        int slot = index(id);
+        return id && slot < m_generations.size() && m_generations[slot] == generation(id);
+    }
+
+    /**
+     * @brief index The slot index of an id, the position in a flat table of the objects.
+     */
+    static constexpr int index(quint32 id) {
+        return id & ((1u << INDEX_BITS) - 1);
+    }
+
+    /**
+     * @brief generation The generation of an id.
+     */
+    static constexpr quint32 generation(quint32 id) {
+        return id >> INDEX_BITS;
+    }
+
+private:
+    /**
+     * @brief m_generations The current generation of each slot.
+     */
+    QList<quint32> m_generations;
+    /**
+     * @brief m_free The slots that can be reused.
+     */
+    QList<int> m_free;
+};
+
+#endif // ENTITYREGISTRY_H
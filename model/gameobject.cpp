@@ -13,41 +13,41 @@ const QPointer<GameObject> GameObject::getNeighbor(double direction, int offset)
         return prt->getNeighbor(direction, offset);
     }
     // The parent of the last GameObject parent is a GameObject model, so it asks it for its neighbor, neighbor.
-    return qobject_cast<GameObjectModel *>(parent())->getNeighbor(m_objectData[DataRole::Position].toPoint(), direction, offset);
+    return qobject_cast<GameObjectModel *>(parent())->getNeighbor(get<DataRole::Position>(), direction, offset);
 }
 const QPointer<GameObject> GameObject::getNeighbor(Direction direction, int offset) const {
     // Kept for laziness reasons.
     return getNeighbor(static_cast<double>(direction), offset);
 }
 const QList<QPointer<GameObject>> GameObject::getAllNeighbors(int offset) const {
-    // I think this ended up looking pretty sweet.
-    auto list = QList<QPointer<GameObject>>();
+    // Propagates like getNeighbor. The angles of the ring used to be visited one by one,
+    // dividing 360 deg by (offset + 1) * 8, the model now reads the whole ring from the NeighborTable.
+    if(auto prt = qobject_cast<GameObject *>(parent())) {
+        return prt->getAllNeighbors(offset);
+    }
+    return qobject_cast<GameObjectModel *>(parent())->getAllNeighbors(get<DataRole::Position>(), offset);
+}
 
-    // Quick reminder that int do not magically cast to doubles. The function
-    // accesses neighbors using angles, by dividing 360 deg by the offset
-    // * 8 we get a geometric increase on the number of tiles.
-    // This might? not work for big offsets, too afraid to try.
-    for(double i = 0; i < 360; i += 360 / (((double)offset + 1) * 8)) {
-        list.append(getNeighbor(i, offset));
+GameObject::~GameObject() {
+    if(auto *model = getModel()) {
+        model->objectDestroyed(this);
     }
-    return list;
 }
 
 bool GameObject::event(QEvent *event) {
     if(event->type() == QEvent::ParentChange) {
-        auto data = getData();
-        // Pass on the data from the parent to the view, the position is the new position after the parent change.
-        // This means that the change direction + the new position form a vector of the movement of the object.
-        data[DataRole::Position] = qobject_cast<GameObject *>(parent())->getData(DataRole::Position);
-        data[DataRole::LatestChange] = QVariant::fromValue<DataRole>(DataRole::Position);
-        data[DataRole::ChangeDirection] = getData(DataRole::Direction);
+        // The new position after the parent change and the direction of the object form a vector of the movement.
+        QPoint position = tilePosition();
+        Direction direction = get<DataRole::Direction>();
 
         // Debug for protagonist only
-        if(data[DataRole::Type].value<ObjectType>() == ObjectType::Protagonist) {
-            qDebug() << data[DataRole::Type].toString() << "Moved To: (" << data[DataRole::Position].toPoint().x() << ", "
-                     << data[DataRole::Position].toPoint().y() << ")" << data[DataRole::ChangeDirection].toString();
+        if(get<DataRole::Type>() == ObjectType::Protagonist) {
+            qDebug() << getData(DataRole::Type).toString() << "Moved To: (" << position.x() << ", "
+                     << position.y() << ")" << QVariant::fromValue<Direction>(direction).toString();
+        }
+        if(auto *model = getModel()) {
+            model->recordChange(this, DataRole::Position, QVariant(), position, position, direction);
         }
-        emit dataChanged(data);
         return true;
     }
 
@@ -55,63 +55,115 @@ bool GameObject::event(QEvent *event) {
 }
 
 void GameObject::setData(DataRole role, QVariant value) {
+    QVariant oldValue = getData(role);
     // Directions are not only angles in a plane, but can also be interpreted as directions of change.
-    Direction dir = value.toFloat() > m_objectData[role].toFloat() ? Direction::Up : Direction::Down;
-    m_objectData[role] = value;
+    Direction dir = value.toFloat() > oldValue.toFloat() ? Direction::Up : Direction::Down;
+    storeData(role, value);
 
-    if(m_objectData[DataRole::Type].value<ObjectType>() == ObjectType::Protagonist) {
-        qDebug() << m_objectData[DataRole::Type].toString() << "Data Changed: " << QVariant::fromValue<DataRole>(role).toString()
-                 << " : " << m_objectData[role].toFloat() << ":" << QVariant::fromValue<Direction>(dir).toString();
+    if(get<DataRole::Type>() == ObjectType::Protagonist) {
+        qDebug() << m_data.value(DataRole::Type).toString() << "Data Changed: " << QVariant::fromValue<DataRole>(role).toString()
+                 << " : " << getData(role).toFloat() << ":" << QVariant::fromValue<Direction>(dir).toString();
     }
 
-    auto data = getData();
-    if(parent() && parent()->inherits("GameObject")) {
-        // Tiles do not have a parent that has a position.
-        data[DataRole::Position] = qobject_cast<GameObject *>(parent())->getData(DataRole::Position);
+    // The model journals the change, the view and the controller get all the changes of a tick at once.
+    if(auto *model = getModel()) {
+        model->recordChange(this, role, oldValue, getData(role), tilePosition(), dir);
     }
-    // These data roles are never stored in the GameObjects
-    data[DataRole::LatestChange] = QVariant::fromValue<DataRole>(role);
-    data[DataRole::ChangeDirection] = QVariant::fromValue<Direction>(dir);
-
-    emit dataChanged(data);
 }
 
 void GameObject::setData(QList<QPair<DataRole, QVariant>> data) {
     for(const auto &pair : data) {
-        m_objectData[pair.first] = pair.second;
+        storeData(pair.first, pair.second);
     }
 }
 
 void GameObject::setData(const QMap<DataRole, QVariant> &data) {
-    m_objectData = QMap<DataRole, QVariant>(data);
+    setData(ObjectData(data));
 }
 
-const QPointer<GameObject> GameObject::findChild(ObjectType type) {
-    auto children = findChildren<GameObject *>();
-    for(auto child : children) {
-        if(child->getData(DataRole::Type).value<ObjectType>() == type) {
-            return child;
+void GameObject::setData(const ObjectData &data) {
+    m_data = data;
+    if(m_grid) {
+        // Move the grid roles back where they belong.
+        attach(m_grid, m_cell);
+    }
+}
+
+void GameObject::storeData(DataRole role, const QVariant &value) {
+    if(m_grid && WorldGrid::isGridRole(role)) {
+        m_grid->setValue(m_cell, role, value);
+        return;
+    }
+    m_data.setValue(role, value);
+}
+
+void GameObject::attach(WorldGrid *grid, int cell) {
+    m_grid = grid;
+    m_cell = cell;
+    for(int i = 0; i < ObjectData::ROLE_COUNT; ++i) {
+        auto role = static_cast<DataRole>(i);
+        if(WorldGrid::isGridRole(role) && m_data.contains(role)) {
+            m_grid->setValue(m_cell, role, m_data.value(role));
+            m_data.remove(role);
         }
     }
-    return nullptr;
+    m_grid->setTile(m_cell, this);
+    m_grid->setOccupants(m_cell, occupantMask());
+}
+
+void GameObject::childEvent(QChildEvent *event) {
+    // On ChildRemoved the child might be half destroyed, it is only compared, never cast.
+    if(event->added()) {
+        if(auto *obj = qobject_cast<GameObject *>(event->child())) {
+            m_occupants.append(obj);
+        }
+    } else if(event->removed()) {
+        QObject *child = event->child();
+        m_occupants.removeIf([child](GameObject *occupant) {
+            return occupant == child;
+        });
+    }
+
+    if(m_grid && (event->added() || event->removed())) {
+        m_grid->setOccupants(m_cell, occupantMask());
+    }
+    QObject::childEvent(event);
+}
+
+quint8 GameObject::occupantMask() const {
+    quint8 mask = 0;
+    forEachOccupant([&mask](GameObject *occupant) {
+        mask |= WorldGrid::typeBit(occupant->get<DataRole::Type>());
+    });
+    return mask;
 }
+
+const QPointer<GameObject> GameObject::findChild(ObjectType type) {
+    return findChild({type, type});
+}
+
 const QPointer<GameObject> GameObject::findChild(QPair<ObjectType, ObjectType> range) {
     // Object type can have ranges to find several objects related to eachother.
-    auto children = findChildren<GameObject *>();
-    for(auto child : children) {
-        int type = child->getData(DataRole::Type).toInt();
+    quint8 mask = WorldGrid::typeMask(range);
+    if(m_grid && mask && !(m_grid->occupants(m_cell) & mask)) {
+        // Nothing of that type on this tile, no need to look at the children.
+        return nullptr;
+    }
+    for(auto *occupant : m_occupants) {
+        int type = (int)occupant->get<DataRole::Type>();
         if(type >= (int)range.first && type <= (int)range.second) {
-            return child;
+            return occupant;
         }
     }
     return nullptr;
 }
 
 bool GameObject::hasChild(QPair<ObjectType, ObjectType> range) const {
-    auto children = getAllData(false);
-
-    return std::any_of(children.begin(), children.end(), [&range](const QMap<DataRole, QVariant> &obj) {
-        int type = obj[DataRole::Type].toInt();
+    if(m_grid) {
+        return m_grid->occupants(m_cell) & WorldGrid::typeMask(range);
+    }
+    return std::any_of(m_occupants.begin(), m_occupants.end(), [&range](const GameObject *occupant) {
+        int type = (int)occupant->get<DataRole::Type>();
         return type >= (int)range.first && type <= (int)range.second;
     });
 }
@@ -125,31 +177,50 @@ const GameObject *GameObject::nearest(ObjectType type) const {
 }
 
 const GameObject *GameObject::nearest(QPair<ObjectType, ObjectType> range) const {
-    auto filter = [&range](QPointer<GameObject> obj) { return obj.isNull() ? false : obj->hasChild(range); };
-    auto comp = [](QPointer<GameObject> a) { return a.isNull(); };
-    int i = 0;
-
-    while(true) {
-        auto tiles = getAllNeighbors(i);
-        if(std::all_of(tiles.begin(), tiles.end(), comp)) {
-            // When the map has been exhausted do not loop any more.
-            return nullptr;
-        }
-        auto it = std::find_if(tiles.begin(), tiles.end(), filter);
-        if(it != tiles.end()) {
-            return *it;
-        }
+    // Propagates like getNeighbor, the model answers with its spatial index instead of growing rings of tiles.
+    if(auto prt = qobject_cast<GameObject *>(parent())) {
+        return prt->nearest(range);
+    }
+    return qobject_cast<GameObjectModel *>(parent())->nearest(get<DataRole::Position>(), range);
+}
 
-        i++;
-    };
+void GameObject::schedule(const QSharedPointer<Behavior> &behavior, int delay) {
+    if(auto *model = getModel()) {
+        model->schedule(behavior, delay);
+    }
+}
+
+GameObjectModel *GameObject::getModel() const {
+    // Propagates like getNeighbor. While a level is being destroyed the casts fail, so it returns null.
+    if(auto prt = qobject_cast<GameObject *>(parent())) {
+        return prt->getModel();
+    }
+    return qobject_cast<GameObjectModel *>(parent());
+}
+
+QPoint GameObject::tilePosition() const {
+    // Tiles do not have a parent that has a position.
+    if(auto prt = qobject_cast<GameObject *>(parent())) {
+        return prt->get<DataRole::Position>();
+    }
+    return get<DataRole::Position>();
 }
 
 QVariant GameObject::getData(DataRole role) const {
-    return m_objectData[role];
+    if(m_grid && WorldGrid::isGridRole(role)) {
+        return m_grid->value(m_cell, role);
+    }
+    return m_data.value(role);
 }
 
 QMap<DataRole, QVariant> GameObject::getData() const {
-    return m_objectData;
+    auto data = m_data.toMap();
+    if(m_grid) {
+        for(auto role : {DataRole::Energy, DataRole::PoisonLevel, DataRole::Position, DataRole::Path}) {
+            data.insert(role, m_grid->value(m_cell, role));
+        }
+    }
+    return data;
 }
 
 QList<QMap<DataRole, QVariant>> GameObject::getAllData(bool self) const {
@@ -6,12 +6,19 @@
 
 #include <QEvent>
 #include <QPointer>
+#include <QVarLengthArray>
 #include <QVariant>
-#include <typeindex>
+#include <array>
 
 #include "publicenums.h"
+#include "model/objectdata.h"
+#include "model/objectpool.h"
+#include "model/worldgrid.h"
 #include "model/behaviors/behavior.h"
 
+// Foward declaration of GameObjectModel
+class GameObjectModel;
+
 /**
  * @brief The GameObject class represents an individual entity within the game world, capable of various interactions and states.
  */
@@ -23,17 +30,36 @@ public:
      * @param objectData A map of data roles to their corresponding values.
      */
     GameObject(QMap<DataRole, QVariant> objectData)
-        : m_objectData(objectData) {};
+        : m_data(objectData) {};
 
     /**
      * @brief Default constructor for GameObject.
      */
-    GameObject() { m_objectData = QMap<DataRole, QVariant>(); };
+    GameObject() {};
+
+    /**
+     * @brief Destructor for GameObject, lets the model keep the data of its pending changes and free its id.
+     */
+    ~GameObject();
 
+    ///@{
     /**
-     * @brief Destructor for GameObject.
+     * @brief GameObjects made with new (pool) come from the ObjectPool of their level, the others from the heap.
+     * delete gives the memory back to wherever it came from.
      */
-    ~GameObject() {};
+    static void *operator new(std::size_t size) {
+        return ObjectPool::allocate(size, nullptr);
+    }
+    static void *operator new(std::size_t size, ObjectPool &pool) {
+        return ObjectPool::allocate(size, &pool);
+    }
+    static void operator delete(void *object) {
+        ObjectPool::release(object);
+    }
+    static void operator delete(void *object, ObjectPool &) {
+        ObjectPool::release(object);
+    }
+    ///@}
 
     /**
      * @brief Finds a child GameObject of a specified type.
@@ -43,6 +69,44 @@ public:
     const QPointer<GameObject> findChild(ObjectType type);
 
     // Data getters and setters.
+    /**
+     * @brief Typed getter for the hot paths, reads the slot directly without a QVariant.
+     * Tiles read their grid roles from the WorldGrid of the level.
+     * @return The value stored for the role, or the default value of its type if it is not set.
+     */
+    template <DataRole R>
+    ObjectData::RoleType<R> get() const {
+        if constexpr(WorldGrid::isGridRole(R)) {
+            if(m_grid) {
+                return m_grid->get<R>(m_cell);
+            }
+        }
+        return m_data.get<R>();
+    }
+
+    /**
+     * @brief Attaches a tile to a cell of the grid. The grid roles the tile has are moved into the grid,
+     * from then on the tile is a view on that cell.
+     * @param grid The grid of the level.
+     * @param cell The index of the cell in the grid.
+     */
+    void attach(WorldGrid *grid, int cell);
+
+    /**
+     * @brief Detaches a tile from its cell, the grid keeps the values of the cell and the occupant mask
+     * no longer follows the children. Used right before the tile is deleted when its chunk goes cold.
+     */
+    void detach() {
+        m_grid = nullptr;
+    }
+
+    /**
+     * @brief The data stored in the object itself, without the grid roles of a tile.
+     */
+    const ObjectData &objectData() const {
+        return m_data;
+    }
+
     /**
      * @brief Gets data for a specific role.
      * @param role The role for which data is requested.
@@ -99,12 +163,12 @@ public:
      */
     const QPointer<GameObject> getNeighbor(Direction direction, int offset = 0) const;
     /**
-     * @brief Sets a behavior for the GameObject.
+     * @brief Sets a behavior for the GameObject. The behavior goes in the slot of its interface T.
      * @param behavior The behavior to set.
      */
     template <typename T, typename = std::enable_if<std::is_base_of<Behavior, T>::value>::type>
     void setBehavior(QSharedPointer<T> behavior) {
-        m_behaviors[typeid(T)] = behavior;
+        m_behaviors[slot<T>()] = behavior;
     }
     /**
      * @brief Gets a behavior of the GameObject.
@@ -112,31 +176,71 @@ public:
      */
     template <typename T, typename = std::enable_if<std::is_base_of<Behavior, T>::value>::type>
     QSharedPointer<T> getBehavior() const {
-        auto behavior = m_behaviors[typeid(T)];
-        return qSharedPointerDynamicCast<T>(behavior);
+        // Only a T can be in the slot of T, so no dynamic cast is needed.
+        return qSharedPointerCast<T>(m_behaviors[slot<T>()]);
     }
     /**
      * @brief Removes a behavior from the GameObject.
      */
     template <typename T, typename = std::enable_if<std::is_base_of<Behavior, T>::value>::type>
     void removeBehavior() {
-        m_behaviors.remove(typeid(T));
+        m_behaviors[slot<T>()].reset();
     }
 
     /**
-     * @brief Gets all behaviors of the GameObject.
+     * @brief Gets the behaviors of this GameObject only, one per behavior type.
      * @return A list of shared pointers to the behaviors.
      */
-    template <typename T, typename = std::enable_if<std::is_base_of<Behavior, T>::value>::type>
-    const QList<QSharedPointer<T>> getAllBehaviors() const {
-        auto list = QList<QSharedPointer<T>>();
-        list.append(qSharedPointerDynamicCast<T>(m_behaviors[typeid(T)]));
-
-        for(auto *child : findChildren<GameObject *>()) {
-            list.append(qSharedPointerDynamicCast<T>(child->getBehavior<T>()));
+    const QList<QSharedPointer<Behavior>> getBehaviors() const {
+        QList<QSharedPointer<Behavior>> list;
+        for(const auto &behavior : m_behaviors) {
+            if(behavior) {
+                list.append(behavior);
+            }
         }
         return list;
-    };
+    }
+
+    /**
+     * @brief Schedules a behavior in the TickScheduler of the level. Propagates like getNeighbor,
+     * nothing happens if the object is not in a GameObjectModel.
+     * @param behavior The behavior to call.
+     * @param delay The number of ticks until it is called.
+     */
+    void schedule(const QSharedPointer<Behavior> &behavior, int delay = 1);
+
+    /**
+     * @brief Calls visit with every direct child of this object, the objects standing on a tile.
+     * Nothing is allocated, and an occupant that is deleted or moves away during visit
+     * (killed, picked up) does not break the loop.
+     * @param visit Callable taking a GameObject *.
+     */
+    template <typename F>
+    void forEachOccupant(F &&visit) const {
+        for(qsizetype i = 0; i < m_occupants.size();) {
+            GameObject *occupant = m_occupants[i];
+            visit(occupant);
+            // If the occupant left, the next one took its place.
+            if(i < m_occupants.size() && m_occupants[i] == occupant) {
+                ++i;
+            }
+        }
+    }
+
+    /**
+     * @brief Calls visit with the behavior T of this object and then of each of its occupants.
+     * Objects without a T are visited with a null pointer, the visitor holds a reference so the
+     * behavior outlives its owner if visit deletes it. The object is passed along since shared
+     * behaviors do not know it.
+     * @param visit Callable taking a GameObject * and a const QSharedPointer<T> &.
+     */
+    template <typename T, typename F, typename = std::enable_if<std::is_base_of<Behavior, T>::value>::type>
+    void forEachBehavior(F &&visit) {
+        visit(this, getBehavior<T>());
+        forEachOccupant([&visit](GameObject *occupant) {
+            visit(occupant, occupant->getBehavior<T>());
+        });
+    }
 
     /**
      * @brief Event handler override.
@@ -145,19 +249,31 @@ public:
      */
     bool event(QEvent *event) override;
 
+    /**
+     * @brief Child event handler override, tiles keep the occupant mask of their cell up to date.
+     * @param event The child event.
+     */
+    void childEvent(QChildEvent *event) override;
+
     /**
      * @brief Sets the GameObject's data.
      * @param data The data to set.
      */
     void setData(const QMap<DataRole, QVariant> &data);
 
+    /**
+     * @brief Replaces all the data of the GameObject, like the map overload without building a map.
+     * @param data The data to set.
+     */
+    void setData(const ObjectData &data);
+
     /**
      * @brief Equality comparison operator.
      * @param obj The GameObject to compare with.
      * @return True if equal.
      */
     bool operator==(GameObject const &obj) const {
-        return m_objectData[DataRole::Type].value<ObjectType>() == obj;
+        return get<DataRole::Type>() == obj;
     }
 
     /**
@@ -167,7 +283,7 @@ public:
      */
 
     bool operator==(ObjectType const &type) const {
-        return m_objectData[DataRole::Type].value<ObjectType>() == type;
+        return get<DataRole::Type>() == type;
     }
 
     /**
@@ -207,24 +323,59 @@ public:
 
 private:
     /**
-     * @brief m_behaviors Map of Behavior std::type_index to their shared pointers.
+     * @brief Finds the GameObjectModel of the level by going up the parents.
+     * @return The model, null if the object is not in a level.
      */
-    QMap<std::type_index, QSharedPointer<Behavior>> m_behaviors;
+    GameObjectModel *getModel() const;
+
     /**
-     * @brief m_behaviors Map of DataRole to their values QVariant.
+     * @brief The position of the tile this object is on, its own position for tiles.
      */
-    QMap<DataRole, QVariant> m_objectData;
+    QPoint tilePosition() const;
 
-signals:
     /**
-     * @brief Signal emitted when the data of the GameObject changes.
-     * @param objectData The changed data of the GameObject.
+     * @brief Stores one role, in the grid for the grid roles of a tile and in m_data otherwise.
+     * @param role The role to store.
+     * @param value The value to store.
+     */
+    void storeData(DataRole role, const QVariant &value);
+
+    /**
+     * @brief Computes the occupant mask of the direct children of this object.
+     * @return The mask with the bit of every child type.
+     */
+    quint8 occupantMask() const;
+
+    /**
+     * @brief slot The index of the slot of a behavior interface in m_behaviors.
+     */
+    template <typename T>
+    static constexpr int slot() {
+        static_assert(T::SLOT != BehaviorSlot::Count, "Behaviors are stored by interface.");
+        return static_cast<int>(T::SLOT);
+    }
+
+    /**
+     * @brief m_occupants The direct children of this object, kept in childEvent so the
+     * behaviors can go through them without findChildren.
+     */
+    QVarLengthArray<GameObject *, 4> m_occupants;
+    /**
+     * @brief m_behaviors The behaviors of this object, one slot per BehaviorSlot.
+     */
+    std::array<QSharedPointer<Behavior>, static_cast<int>(BehaviorSlot::Count)> m_behaviors;
+    /**
+     * @brief m_data Typed storage of the DataRoles of this object.
+     */
+    ObjectData m_data;
+    /**
+     * @brief m_grid The grid this tile is a view of, null for everything that is not a tile.
      */
-    void dataChanged(QMap<DataRole, QVariant> objectData);
+    WorldGrid *m_grid = nullptr;
     /**
-     * @brief Signal emitted to indicate a game tick.
+     * @brief m_cell The index of the cell of this tile in m_grid.
      */
-    void tick();
+    int m_cell = -1;
 };
 
 #endif // GAMEOBJECT_H
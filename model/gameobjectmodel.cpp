@@ -1,15 +1,70 @@
 #include "gameobjectmodel.h"
+#include "gameobjectsettings.h"
+#include "neighbortable.h"
+#include "model/pathfinding/costgrid.h"
 #include <QTransform>
 #include <math.h>
+#include <utility>
+GameObjectModel::~GameObjectModel() {
+    m_destroying = true;
+    // Detached first, the grid and the distance fields do not need to follow the objects that go.
+    for(int cell = 0; cell < m_grid.size(); ++cell) {
+        if(auto *tile = m_grid.tile(cell)) {
+            tile->detach();
+            m_grid.setTile(cell, nullptr);
+        }
+    }
+    // The GameObjects go before the pool, in the order they were added so each one is the first child.
+    const auto tiles = children();
+    for(auto *tile : tiles) {
+        delete tile;
+    }
+}
+
 int GameObjectModel::getRowCount() const {
-    return m_world[0].size();
+    return m_grid.getRowCount();
 }
 
 int GameObjectModel::getColumnCount() const {
-    return m_world.size();
+    return m_grid.getColumnCount();
 }
 
 const QPointer<GameObject> GameObjectModel::getNeighbor(QPoint location, double direction, int offset) const {
+    QPoint point;
+    if(!NeighborTable::offset(direction, offset, &point)) {
+        point = geometricNeighbor(direction, offset);
+    }
+
+    int x = location.x() + point.x();
+    int y = location.y() + point.y();
+
+    // No tile access allowed in the void.
+    if(!m_grid.contains(x, y)) {
+        return QPointer<GameObject>(nullptr);
+    }
+    return tile(m_grid.index(x, y));
+}
+
+const QList<QPointer<GameObject>> GameObjectModel::getAllNeighbors(QPoint location, int offset) const {
+    auto ring = NeighborTable::ring(offset);
+    auto list = QList<QPointer<GameObject>>();
+    list.reserve(ring.size());
+    for(const auto &point : ring) {
+        int x = location.x() + point.x();
+        int y = location.y() + point.y();
+        // Tiles outside of the map are still in the list as null, nearest() counts on it.
+        list.append(m_grid.contains(x, y) ? tile(m_grid.index(x, y)) : nullptr);
+    }
+    return list;
+}
+
+const GameObject *GameObjectModel::nearest(QPoint location, QPair<ObjectType, ObjectType> range) const {
+    int cell = m_grid.nearest(location, WorldGrid::typeMask(range));
+    return cell < 0 ? nullptr : tile(cell);
+}
+
+QPoint GameObjectModel::geometricNeighbor(double direction, int offset) {
+    // Only used for angles that are not in the NeighborTable.
     // The other method of using simple trig was causing some issues with big offsets.
     // This might be somewhat slower but works quite well. The whole game is based on directions relative to
     // the GameObjects since this makes behaviors very easy to program and fits well with the way objects are displayed.
@@ -29,15 +84,7 @@ const QPointer<GameObject> GameObjectModel::getNeighbor(QPoint location, double
     }
 
     // This intersection is the grid location relative to the object.
-    auto point = pointF.toPoint();
-    int x = location.x() + point.x();
-    int y = location.y() + point.y();
-
-    // No tile access allowed in the void.
-    if(0 > x || 0 > y || x >= getColumnCount() || y >= getRowCount()) {
-        return QPointer<GameObject>(nullptr);
-    }
-    return m_world.at(x).at(y);
+    return pointF.toPoint();
 }
 
 QList<QList<QMap<DataRole, QVariant>>> GameObjectModel::getAllData(bool) const {
@@ -45,7 +92,8 @@ QList<QList<QMap<DataRole, QVariant>>> GameObjectModel::getAllData(bool) const {
     for(int x = 0; x < getColumnCount(); ++x) {
         list.append(QList<QMap<DataRole, QVariant>>());
         for(int y = 0; y < getRowCount(); ++y) {
-            list[x].append(m_world[x][y]->getData());
+            auto *tile = m_grid.tile(m_grid.index(x, y));
+            list[x].append(tile ? tile->getData() : QMap<DataRole, QVariant>());
         }
     }
     return list;
@@ -57,47 +105,292 @@ QList<QList<QList<QMap<DataRole, QVariant>>>> GameObjectModel::getAllData() cons
     for(int x = 0; x < getColumnCount(); ++x) {
         list.append(QList<QList<QMap<DataRole, QVariant>>>());
         for(int y = 0; y < getRowCount(); ++y) {
-            list[x].append(m_world[x][y]->getAllData());
+            auto *tile = m_grid.tile(m_grid.index(x, y));
+            list[x].append(tile ? tile->getAllData() : QList<QMap<DataRole, QVariant>>());
         }
     }
     return list;
 }
 
 QPointer<GameObject> GameObjectModel::getObject(int x, int y, ObjectType type) const {
-    if(y > getRowCount() || x > getColumnCount()) {
+    if(!m_grid.contains(x, y)) {
         return QPointer<GameObject>(nullptr);
     }
 
-    auto tile = m_world[x][y];
+    int cell = m_grid.index(x, y);
     if(type == ObjectType::Tile) {
-        return tile;
+        return tile(cell);
     }
 
-    return tile->findChild(type);
+    if(!(m_grid.occupants(cell) & WorldGrid::typeBit(type))) {
+        return QPointer<GameObject>(nullptr);
+    }
+    return tile(cell)->findChild(type);
 }
 
 QList<QPointer<GameObject>> GameObjectModel::getObject(ObjectType type) const {
     QList<QPointer<GameObject>> list {};
-    for(int x = 0; x < getColumnCount(); ++x) {
-        for(int y = 0; y < getRowCount(); ++y) {
-            if(auto tile = getObject(x, y, type)) {
+    if(type == ObjectType::Tile) {
+        for(int cell = 0; cell < m_grid.size(); ++cell) {
+            if(auto *tile = m_grid.tile(cell)) {
                 list.append(tile);
             }
         }
+        return list;
+    }
+
+    // Only the occupant masks are scanned, the tiles are touched when the type is there.
+    quint8 bit = WorldGrid::typeBit(type);
+    for(int cell = 0; cell < m_grid.size(); ++cell) {
+        if(m_grid.occupants(cell) & bit) {
+            list.append(tile(cell)->findChild(type));
+        }
     }
     return list;
 }
 
 void GameObjectModel::setItem(int x, int y, QPointer<GameObject> object) {
-    if(y > getRowCount() || x > getColumnCount()) {
+    if(!m_grid.contains(x, y)) {
+        throw "Cannot set outside range";
+    }
+
+    int cell = m_grid.index(x, y);
+    object->setData(QList<QPair<DataRole, QVariant>> {{DataRole::Id, m_entities.create()}});
+    if(object->get<DataRole::Type>() == ObjectType::Tile) {
+        delete tile(cell);
+        m_placing = true;
+        object->setParent(this);
+        m_placing = false;
+        object->attach(&m_grid, cell);
+        return;
+    }
+
+    auto *parent = tile(cell);
+    m_placing = true;
+    object->setParent(parent);
+    m_placing = false;
+    // Every behavior gets one tick to decide if it needs more, tiles never do.
+    for(const auto &behavior : object->getBehaviors()) {
+        m_scheduler.schedule(behavior);
+    }
+
+    // The entry door is also a doorway, only the one going up is the exit.
+    if(object->get<DataRole::Type>() == ObjectType::Doorway && object->get<DataRole::Direction>() == Direction::Up) {
+        m_exitField.addSource(cell);
+    }
+}
+
+DistanceField &GameObjectModel::getDistanceField(DistanceField::Target target) {
+    switch(target) {
+    case DistanceField::Target::Enemies:
+        return m_enemyField;
+    case DistanceField::Target::HealthPacks:
+        return m_healthPackField;
+    default:
+        return m_exitField;
+    }
+}
+
+void GameObjectModel::recordChange(const GameObject *object, DataRole role, const QVariant &oldValue,
+                                   const QVariant &newValue, QPoint position, Direction direction) {
+    if(role == DataRole::Position && object->get<DataRole::Type>() == ObjectType::Protagonist) {
+        m_focus = m_chunks.chunkOf(position.x(), position.y());
+    }
+    if(m_placing) {
+        // Placing an object is not a move, the view gets it with the level or its chunk,
+        // and a door that is placed must not look like a door that is used.
+        return;
+    }
+
+    if(m_journal.isEmpty()) {
+        // Changes made outside of a tick (the path, a level change) still get to the view before the next paint.
+        QMetaObject::invokeMethod(this, &GameObjectModel::flushChanges, Qt::QueuedConnection);
+    }
+    m_journal.record(object, role, oldValue, newValue, position, direction);
+}
+
+void GameObjectModel::tick() {
+    m_scheduler.advance();
+    flushChanges();
+    // After the flush, the view has to move the objects that left a chunk before the chunk is removed.
+    if(m_chunks.isStreamed() && m_scheduler.now() % ChunkMap::SETTINGS::UPDATE_TICKS == 0) {
+        updateChunks();
+    }
+}
+
+void GameObjectModel::flushChanges() {
+    if(!m_journal.isEmpty()) {
+        emit dataChanged(m_journal.take());
+    }
+}
+
+void GameObjectModel::setTerrain(int x, int y, float energy, int poisonLevel) {
+    int cell = m_grid.index(x, y);
+    m_grid.setValue(cell, DataRole::Energy, energy);
+    m_grid.setValue(cell, DataRole::PoisonLevel, poisonLevel);
+}
+
+void GameObjectModel::addObject(int x, int y, const ObjectData &data) {
+    if(!m_grid.contains(x, y)) {
         throw "Cannot set outside range";
     }
 
-    if(object->getData(DataRole::Type).value<ObjectType>() == ObjectType::Tile) {
-        delete m_world[x][y];
-        m_world[x][y] = object;
+    int chunk = m_chunks.chunkOf(x, y);
+    if(m_chunks.isMaterialized(chunk)) {
+        setItem(x, y, makeObject(data));
         return;
     }
 
-    object->setParent(m_world[x][y]);
+    // Same bookkeeping as setItem, without the GameObject.
+    int cell = m_grid.index(x, y);
+    ObjectType type = data.get<DataRole::Type>();
+    m_chunks.objects(chunk).append({QPoint(x, y), data});
+    m_grid.setOccupants(cell, m_grid.occupants(cell) | WorldGrid::typeBit(type));
+    if(type == ObjectType::Protagonist) {
+        m_focus = chunk;
+    }
+    if(type == ObjectType::Doorway && data.get<DataRole::Direction>() == Direction::Up) {
+        m_exitField.addSource(cell);
+    }
+}
+
+void GameObjectModel::updateChunks() {
+    qint64 now = m_scheduler.now();
+    for(int chunk = 0; chunk < m_chunks.count(); ++chunk) {
+        bool hot = !m_chunks.isStreamed() || m_chunks.distance(chunk, m_focus) <= ChunkMap::SETTINGS::HOT_RADIUS;
+        if(hot) {
+            if(!m_chunks.isMaterialized(chunk)) {
+                materialize(chunk);
+            }
+        } else if(m_chunks.isMaterialized(chunk) && now - m_chunks.materializedAt(chunk) >= ChunkMap::SETTINGS::UPDATE_TICKS
+                  && !isActive(chunk)) {
+            dematerialize(chunk);
+        }
+    }
+}
+
+void GameObjectModel::markPath(QPoint from, const std::vector<int> &moves) {
+    QPoint position = from;
+    for(int move : moves) {
+        position += CostGrid::MOVES[move];
+        int cell = m_grid.index(position.x(), position.y());
+        if(auto *tile = m_grid.tile(cell)) {
+            // The view only has items for the tiles of materialized chunks.
+            tile->setData(DataRole::Path, true);
+        } else {
+            m_grid.setValue(cell, DataRole::Path, true);
+        }
+    }
+}
+
+GameObject *GameObjectModel::tile(int cell) const {
+    if(auto *tile = m_grid.tile(cell)) {
+        return tile;
+    }
+    QPoint position = m_grid.position(cell);
+    const_cast<GameObjectModel *>(this)->materialize(m_chunks.chunkOf(position.x(), position.y()));
+    return m_grid.tile(cell);
+}
+
+void GameObjectModel::materialize(int chunk) {
+    auto area = m_chunks.area(chunk);
+    m_chunks.setMaterialized(chunk, m_scheduler.now());
+
+    // The tiles get their objects before they are attached, so the occupant masks of the grid
+    // (and the distance fields that follow them) do not change.
+    m_placing = true;
+    auto setTile = GameObjectSettings::getFunction(ObjectType::Tile);
+    ObjectData data = GameObjectSettings::getDefaultData(ObjectType::Tile);
+    for(int x = area.left(); x <= area.right(); ++x) {
+        for(int y = area.top(); y <= area.bottom(); ++y) {
+            int cell = m_grid.index(x, y);
+            data.set<DataRole::Energy>(m_grid.get<DataRole::Energy>(cell));
+            data.set<DataRole::PoisonLevel>(m_grid.get<DataRole::PoisonLevel>(cell));
+            data.set<DataRole::Position>(QPoint(x, y));
+            data.set<DataRole::Id>(m_entities.create());
+
+            auto *tile = new(m_pool) GameObject();
+            setTile(tile);
+            // The data of the cell replaces the defaults of the type.
+            tile->setData(data);
+            tile->setParent(this);
+            m_grid.setTile(cell, tile);
+        }
+    }
+    m_placing = false;
+
+    for(const auto &object : std::exchange(m_chunks.objects(chunk), {})) {
+        setItem(object.position.x(), object.position.y(), makeObject(object.data));
+    }
+
+    for(int x = area.left(); x <= area.right(); ++x) {
+        for(int y = area.top(); y <= area.bottom(); ++y) {
+            int cell = m_grid.index(x, y);
+            m_grid.tile(cell)->attach(&m_grid, cell);
+        }
+    }
+
+    if(m_chunks.isStreamed()) {
+        QList<QList<QList<QMap<DataRole, QVariant>>>> tiles;
+        for(int x = area.left(); x <= area.right(); ++x) {
+            tiles.append(QList<QList<QMap<DataRole, QVariant>>>());
+            for(int y = area.top(); y <= area.bottom(); ++y) {
+                tiles.last().append(m_grid.tile(m_grid.index(x, y))->getAllData());
+            }
+        }
+        emit tilesAdded(area.topLeft(), tiles);
+    }
+}
+
+void GameObjectModel::dematerialize(int chunk) {
+    auto area = m_chunks.area(chunk);
+    auto &objects = m_chunks.objects(chunk);
+    for(int x = area.left(); x <= area.right(); ++x) {
+        for(int y = area.top(); y <= area.bottom(); ++y) {
+            int cell = m_grid.index(x, y);
+            auto *tile = m_grid.tile(cell);
+            // The occupant mask of the cell stays as it is, it now stands for the packed objects.
+            tile->detach();
+            m_grid.setTile(cell, nullptr);
+            // The objects are deleted before their tile, so they still find the model to release their ids.
+            tile->forEachOccupant([&objects, x, y](GameObject *occupant) {
+                objects.append({QPoint(x, y), occupant->objectData()});
+                delete occupant;
+            });
+            delete tile;
+        }
+    }
+    m_chunks.setMaterialized(chunk, -1);
+    emit tilesRemoved(area);
+}
+
+bool GameObjectModel::isActive(int chunk) const {
+    auto area = m_chunks.area(chunk);
+    for(int x = area.left(); x <= area.right(); ++x) {
+        for(int y = area.top(); y <= area.bottom(); ++y) {
+            int cell = m_grid.index(x, y);
+            if(!m_grid.occupants(cell)) {
+                continue;
+            }
+
+            bool active = false;
+            m_grid.tile(cell)->forEachOccupant([&active](GameObject *occupant) {
+                for(const auto &behavior : occupant->getBehaviors()) {
+                    active |= behavior->isScheduled();
+                }
+            });
+            if(active) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+GameObject *GameObjectModel::makeObject(const ObjectData &data) {
+    auto *object = new(m_pool) GameObject();
+    GameObjectSettings::getFunction(data.get<DataRole::Type>())(object);
+    // The data replaces the defaults of the type, the id is given again by setItem.
+    object->setData(data);
+    return object;
 }
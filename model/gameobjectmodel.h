@@ -3,40 +3,46 @@
 #define GAMEOBJECTMODEL_H
 
 #include "gameobject.h"
+#include "changejournal.h"
+#include "chunkmap.h"
+#include "distancefield.h"
+#include "entityregistry.h"
+#include "tickscheduler.h"
+#include "model/pathfinding/dstarlite.h"
 #include <QPoint>
 
 /**
  * @brief The GameObjectModel class represents the model of the game world.
- * It holds a grid of GameObject pointers, representing the game world's layout.
- * It connects all of its child objects to a signal. This makes it very convinient to connect
- * and disconnect levels as they change throughout the game since the GameObjects can be simply
- * connected to their parent GameObject, which is then connected to the GameObjectModel
- * for that level, and then it itself is connected to the view/controller to handle
- * the changes in data as needed. As soon as the level is no longer needed a single
- * disconnect has to be done. This does not cause any overhead since the ticks
- * (which work the same way on the opposite direction) are also disconnected.
+ * It holds the WorldGrid of the level, representing the game world's layout.
+ * Its child objects report their data changes to its ChangeJournal, which is delivered to the view/controller
+ * as one batch per tick. This makes it very convinient to connect and disconnect levels as they change
+ * throughout the game since only the GameObjectModel of a level is connected to the view/controller.
+ * As soon as the level is no longer needed a single disconnect has to be done. The ticks go the opposite direction: the model is the only thing
+ * connected, and its TickScheduler calls the behaviors that are due, so a disconnected level costs nothing.
+ * Big levels are streamed: only the chunks (see ChunkMap) around the protagonist, or with behaviors waiting for a tick,
+ * are GameObjects. The others only live in the WorldGrid, and are materialized again as soon as one of their tiles is asked for.
  */
 class GameObjectModel : public QObject {
     Q_OBJECT
 public:
     /**
-     * @brief Constructor for GameObjectModel.
-     * @param world A 2D grid of QPointer to GameObjects representing the game world.
-     */
-    GameObjectModel(QList<QList<QPointer<GameObject>>> world) {
-        m_world = world;
-        for(const auto &row : m_world) {
-            for(const auto &tile : row) {
-                tile->setParent(this);
-                connect(tile, &GameObject::dataChanged, this, &GameObjectModel::dataChanged);
-                for(const auto &obj : tile->children()) {
-                    auto *gameObj = qobject_cast<GameObject *>(obj);
-                    connect(gameObj, &GameObject::dataChanged, this, &GameObjectModel::dataChanged);
-                    connect(this, &GameObjectModel::tick, gameObj, &GameObject::tick);
-                }
-            }
-        }
-    };
+     * @brief Constructor for GameObjectModel, the tiles and the objects are added with setItem.
+     * @param columns The number of columns of the world grid.
+     * @param rows The number of rows of the world grid.
+     */
+    GameObjectModel(int columns, int rows)
+        : m_pool(sizeof(GameObject))
+        , m_grid(columns, rows)
+        , m_chunks(columns, rows)
+        , m_enemyField(&m_grid, WorldGrid::typeMask({ObjectType::_ENEMIES_START, ObjectType::_ENEMIES_END}))
+        , m_healthPackField(&m_grid, WorldGrid::typeBit(ObjectType::HealthPack))
+        , m_exitField(&m_grid, 0)
+        , m_planner(&m_grid) {};
+
+    /**
+     * @brief Destructor for GameObjectModel, deletes the GameObjects of the level before the pool they live in.
+     */
+    ~GameObjectModel();
 
     /**
      * @brief Retrieves a behavior attached to a specific GameObject in the world.
@@ -71,13 +77,86 @@ public:
     QPointer<GameObject> getObject(int x, int y, ObjectType type) const;
 
     /**
-     * @brief Sets a GameObject at a specific location in the world.
+     * @brief Sets a GameObject at a specific location in the world. Tiles replace the tile of
+     * the cell, any other object is placed on top of the tile.
      * @param x The x-coordinate.
      * @param y The y-coordinate.
      * @param object The GameObject to be placed at the specified location.
      */
     void setItem(int x, int y, QPointer<GameObject> object);
 
+    /**
+     * @brief Sets the energy and poison level of a tile without making its GameObject, used to load a level.
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @param energy The energy of the tile, infinite for walls.
+     * @param poisonLevel The poison level of the tile.
+     */
+    void setTerrain(int x, int y, float energy, int poisonLevel = 0);
+
+    /**
+     * @brief Adds an object on top of a tile from its data, used to load a level. The GameObject is only made
+     * if the chunk of the tile is materialized, otherwise the data waits in the chunk.
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @param data The data of the object, the type decides its behaviors.
+     */
+    void addObject(int x, int y, const ObjectData &data);
+
+    /**
+     * @brief Materializes the chunks around the protagonist and lets the chunks that are no longer needed go cold.
+     * Small levels are materialized completely. Called when a level is loaded and regularly by tick().
+     */
+    void updateChunks();
+
+    /**
+     * @brief Reads a grid role of a tile without materializing its chunk.
+     * @param x The x-coordinate.
+     * @param y The y-coordinate.
+     * @return The value of the role for that tile.
+     */
+    template <DataRole R>
+    ObjectData::RoleType<R> getTileData(int x, int y) const {
+        return m_grid.get<R>(m_grid.index(x, y));
+    }
+
+    /**
+     * @brief Marks the tiles of a path with DataRole::Path. Tiles of cold chunks are only marked in the grid,
+     * they are not materialized and show the mark once they are.
+     * @param from The tile the path starts from, it is not marked.
+     * @param moves The moves, encoded like CostGrid::MOVES.
+     */
+    void markPath(QPoint from, const std::vector<int> &moves);
+
+    /**
+     * @brief Calls visit with the location and the data of every object on top of a tile, in materialized and cold chunks.
+     * Nothing is materialized.
+     * @param visit Callable taking a QPoint and a const ObjectData &.
+     */
+    template <typename F>
+    void forEachObject(F &&visit) const {
+        for(int chunk = 0; chunk < m_chunks.count(); ++chunk) {
+            if(!m_chunks.isMaterialized(chunk)) {
+                for(const auto &object : m_chunks.objects(chunk)) {
+                    visit(object.position, object.data);
+                }
+                continue;
+            }
+
+            auto area = m_chunks.area(chunk);
+            for(int x = area.left(); x <= area.right(); ++x) {
+                for(int y = area.top(); y <= area.bottom(); ++y) {
+                    int cell = m_grid.index(x, y);
+                    if(m_grid.occupants(cell)) {
+                        m_grid.tile(cell)->forEachOccupant([&visit, x, y](GameObject *occupant) {
+                            visit(QPoint(x, y), occupant->objectData());
+                        });
+                    }
+                }
+            }
+        }
+    }
+
     /**
      * @brief Gets the row count of the game world.
      * @return The number of rows in the world grid.
@@ -91,20 +170,21 @@ public:
     int getColumnCount() const;
 
     /**
-     * @brief Gets data for all GameObjects in the world.
+     * @brief Gets data for all GameObjects in the world. The tiles of cold chunks have an empty map.
      * @param [unused] An unused parameter.
      * @return A 2D list of data maps for each GameObject.
      */
     QList<QList<QMap<DataRole, QVariant>>> getAllData(bool) const;
 
     /**
-     * @brief Gets data for all GameObjects in the world.
+     * @brief Gets data for all GameObjects in the world. The tiles of cold chunks have an empty list.
      * @return A 3D list containing data maps for each GameObject.
      */
     QList<QList<QList<QMap<DataRole, QVariant>>>> getAllData() const;
 
     /**
-     * @brief Retrieves all GameObjects of a specific type.
+     * @brief Retrieves all GameObjects of a specific type. Only the tiles of materialized chunks are returned,
+     * the chunks of any other type are materialized.
      * @param type The type of GameObject.
      * @return A list of pointers to the requested GameObjects.
      */
@@ -118,23 +198,193 @@ public:
      */
     const QPointer<GameObject> getNeighbor(QPoint location, double direction, int offset) const;
 
+    /**
+     * @brief getAllNeighbors Retrieves the whole ring of neighbors of a tile, in the same order as
+     * calling getNeighbor for every angle of the ring.
+     * @param location Location of the tile we want the neighbors of
+     * @param offset How further are we getting the neighbors, offset 0 = only closest immediate neighbors
+     * @return the neighbors, null for the ones outside of the world.
+     */
+    const QList<QPointer<GameObject>> getAllNeighbors(QPoint location, int offset) const;
+    /**
+     * @brief geometricNeighbor Intersects a ray with the ring of the offset, used for the angles
+     * NeighborTable does not have. This is how every neighbor used to be found, the tests check the tables against it.
+     * @param direction The angle of the ray in degrees.
+     * @param offset The offset of the ring.
+     * @return The grid location relative to the tile.
+     */
+    static QPoint geometricNeighbor(double direction, int offset);
+
+    /**
+     * @brief nearest Finds the closest tile to a location that has an object in a range of types.
+     * @param location Location of the tile to search from, the tile itself is not considered.
+     * @param range The range of ObjectTypes to search for.
+     * @return The tile, or null if there is no such object in the world.
+     */
+    const GameObject *nearest(QPoint location, QPair<ObjectType, ObjectType> range) const;
+
+    /**
+     * @brief getDistanceField Retrieves the distance field to a kind of target, the fields are
+     * kept up to date with the level and are built the first time they are used.
+     * @param target The kind of target.
+     * @return The distance field.
+     */
+    DistanceField &getDistanceField(DistanceField::Target target);
+
+    /**
+     * @brief getPlanner Retrieves the planner that walks the protagonist to a goal, it follows the changes of the level.
+     * @return The planner.
+     */
+    DStarLite &getPlanner() {
+        return m_planner;
+    }
+
+    /**
+     * @brief schedule Calls tick() on a behavior after a number of ticks, see TickScheduler::schedule.
+     * @param behavior The behavior to call.
+     * @param delay The number of ticks.
+     */
+    void schedule(const QSharedPointer<Behavior> &behavior, int delay = 1) {
+        m_scheduler.schedule(behavior, delay);
+    }
+
+    /**
+     * @brief recordChange Adds a data change of an object to the journal, see ChangeJournal::record.
+     * The journal is flushed at the end of the tick, or in the next event loop for changes made outside of a tick.
+     */
+    void recordChange(const GameObject *object, DataRole role, const QVariant &oldValue, const QVariant &newValue,
+                      QPoint position, Direction direction);
+
+    /**
+     * @brief objectDestroyed Called by a GameObject that is destroyed, keeps the data of its pending
+     * changes (see ChangeJournal::forget) and releases its id.
+     * @param object The object that is being destroyed.
+     */
+    void objectDestroyed(const GameObject *object) {
+        if(m_destroying) {
+            // The whole level goes, nobody reads the journal or the ids anymore.
+            return;
+        }
+        m_journal.forget(object);
+        m_entities.release(object->get<DataRole::Id>());
+    }
+
 private:
     /**
-     * @brief m_world The game world represented as a 2D list of game objects.
+     * @brief tile The tile GameObject of a cell, its chunk is materialized if it is cold.
+     * Materializing only changes how the level is stored, so the const getters can do it.
+     * @param cell The index of the cell in the grid.
+     * @return The tile.
      */
-    QList<QList<QPointer<GameObject>>> m_world;
+    GameObject *tile(int cell) const;
 
-signals:
     /**
-     * @brief Signal emitted when the data of a game object changes.
-     * @param objectData The changed data of the game object.
+     * @brief materialize Makes the GameObjects of the tiles and the packed objects of a cold chunk.
+     * @param chunk The chunk.
+     */
+    void materialize(int chunk);
+
+    /**
+     * @brief dematerialize Packs the objects of a chunk and deletes its GameObjects, the tiles stay in the grid.
+     * @param chunk The chunk.
+     */
+    void dematerialize(int chunk);
+
+    /**
+     * @brief isActive Checks if an object of a materialized chunk has a behavior waiting for a tick.
+     * @param chunk The chunk.
+     * @return True if the chunk has to stay materialized.
+     */
+    bool isActive(int chunk) const;
+
+    /**
+     * @brief makeObject Makes the GameObject of an object from its data, with the behaviors of its type.
+     * @param data The data of the object.
+     * @return The object, it has no id and no parent yet.
+     */
+    GameObject *makeObject(const ObjectData &data);
+
+    /**
+     * @brief m_pool The memory of the GameObjects made by the level, declared first so it goes last.
+     */
+    ObjectPool m_pool;
+    /**
+     * @brief m_grid The game world, the tiles are views on this grid.
+     */
+    WorldGrid m_grid;
+    /**
+     * @brief m_chunks Which chunks are materialized and the packed objects of the cold ones.
+     */
+    ChunkMap m_chunks;
+    /**
+     * @brief m_focus The chunk of the protagonist, the chunks around it stay materialized.
      */
-    void dataChanged(QMap<DataRole, QVariant> objectData);
+    int m_focus = 0;
+    /**
+     * @brief m_placing True while objects are being placed, their parent changes are not changes of the level.
+     */
+    bool m_placing = false;
+    /**
+     * @brief m_destroying True while the level is being destroyed.
+     */
+    bool m_destroying = false;
+    ///@{
+    /**
+     * @brief Distance fields to every enemy, every health pack and the exit door.
+     * Declared after m_grid since they observe it.
+     */
+    DistanceField m_enemyField;
+    DistanceField m_healthPackField;
+    DistanceField m_exitField;
+    ///@}
+    /**
+     * @brief m_planner The planner of the walks to a goal, declared after m_grid since it observes it.
+     */
+    DStarLite m_planner;
+    /**
+     * @brief m_scheduler The behaviors waiting for a tick.
+     */
+    TickScheduler m_scheduler;
+    /**
+     * @brief m_journal The changes that have not been delivered yet.
+     */
+    ChangeJournal m_journal;
+    /**
+     * @brief m_entities The ids of the objects of the level.
+     */
+    EntityRegistry m_entities;
 
+public slots:
     /**
-     * @brief Signal emitted for each game tick.
+     * @brief Slot called for each game tick, calls the behaviors that are due and delivers their changes.
      */
     void tick();
+
+    /**
+     * @brief flushChanges Emits the changes in the journal as one batch, if there are any.
+     */
+    void flushChanges();
+
+signals:
+    /**
+     * @brief Signal emitted with the data changes of the game objects, once per tick.
+     * @param changes The changes in the order they happened, see ChangeJournal::take.
+     */
+    void dataChanged(QList<QMap<DataRole, QVariant>> changes);
+
+    /**
+     * @brief Signal emitted when a chunk of a streamed level is materialized, right away, so the view has the
+     * tiles before the changes of the tick that need them.
+     * @param origin The location of the first tile.
+     * @param tiles The data of the tiles of the chunk and their objects, by x then y, like getAllData().
+     */
+    void tilesAdded(QPoint origin, QList<QList<QList<QMap<DataRole, QVariant>>>> tiles);
+
+    /**
+     * @brief Signal emitted when a chunk of a streamed level goes cold, its GameObjects are gone.
+     * @param area The tiles of the chunk.
+     */
+    void tilesRemoved(QRect area);
 };
 
 #endif // GAMEOBJECTMODEL_H
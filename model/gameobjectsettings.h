@@ -63,8 +63,9 @@ class GameObjectSettings {
 
         static void setObject(GameObject *obj) {
             obj->setData(defaultData);
-            obj->setBehavior<Movement>(QSharedPointer<PoisonOnStepBehavior>::create(obj));
-            obj->setBehavior<Poison>(QSharedPointer<GenericPoisoningBehavior>::create(obj));
+            // Tiles only keep their owner, every tile uses the same behaviors.
+            obj->setBehavior<Movement>(Behavior::shared<PoisonOnStepBehavior>());
+            obj->setBehavior<Poison>(Behavior::shared<GenericPoisoningBehavior>());
         };
     };
 
@@ -82,7 +83,7 @@ class GameObjectSettings {
          */
         static void setObject(GameObject *obj) {
             obj->setData(defaultData);
-            obj->setBehavior<Movement>(QSharedPointer<NewLevelOnStep>::create(obj));
+            obj->setBehavior<Movement>(Behavior::shared<NewLevelOnStep>());
         };
     };
 
@@ -101,7 +102,7 @@ class GameObjectSettings {
          */
         static void setObject(GameObject *obj) {
             obj->setData(defaultData);
-            obj->setBehavior<Movement>(QSharedPointer<HealOnStepBehavior>::create(obj));
+            obj->setBehavior<Movement>(Behavior::shared<HealOnStepBehavior>());
             obj->setBehavior<Health>(QSharedPointer<GenericHealingBehavior>::create(obj));
         };
     };
@@ -146,7 +147,7 @@ class GameObjectSettings {
             obj->setData(defaultData);
             obj->setBehavior<Attack>(QSharedPointer<CounterAttackBehavior>::create(obj));
             obj->setBehavior<Health>(QSharedPointer<PoisonOnKilledBehavior>::create(obj));
-            obj->setBehavior<Poison>(QSharedPointer<GenericPoisoningBehavior>::create(obj));
+            obj->setBehavior<Poison>(Behavior::shared<GenericPoisoningBehavior>());
         };
     };
 
@@ -199,6 +200,44 @@ public:
             return EnemySettings::setObject;
         }
     }
+
+    /**
+     * @brief Gets the data a GameObject of a type starts with, without making the GameObject.
+     * @param type The ObjectType of the GameObject.
+     * @return The default data of the type.
+     */
+    static ObjectData getDefaultData(ObjectType type) {
+        const QList<QPair<DataRole, QVariant>> *defaults = nullptr;
+        switch(type) {
+        case ObjectType::Tile:
+            defaults = &TileSettings::defaultData;
+            break;
+        case ObjectType::Doorway:
+            defaults = &DoorSettings::defaultData;
+            break;
+        case ObjectType::HealthPack:
+            defaults = &HealthPackSettings::defaultData;
+            break;
+        case ObjectType::Protagonist:
+            defaults = &ProtagonistSettings::defaultData;
+            break;
+        case ObjectType::PoisonEnemy:
+            defaults = &PoisonEnemySettings::defaultData;
+            break;
+        case ObjectType::MovingEnemy:
+            defaults = &MovingEnemySettings::defaultData;
+            break;
+        default:
+            defaults = &EnemySettings::defaultData;
+            break;
+        }
+
+        ObjectData data;
+        for(const auto &pair : *defaults) {
+            data.setValue(pair.first, pair.second);
+        }
+        return data;
+    }
 };
 
 #endif // GAMEOBJECTSETTINGS_H
@@ -0,0 +1,47 @@
+#include "gamerandom.h"
+
+#include <sstream>
+
+GameRandom &GameRandom::global() {
+    static GameRandom random;
+    return random;
+}
+
+void GameRandom::seed(quint32 seed) {
+    m_seed = seed;
+    m_engine.seed(seed);
+}
+
+int GameRandom::bounded(int lowest, int highest) {
+    if(highest <= lowest) {
+        return lowest;
+    }
+    // Scaled like QRandomGenerator does, so every platform draws the same numbers from the same state.
+    quint64 range = (quint64)((qint64)highest - lowest);
+    return lowest + (int)((m_engine() * range) >> 32);
+}
+
+double GameRandom::generateDouble() {
+    // 53 random bits, the precision of a double.
+    quint64 high = m_engine() >> 5;
+    quint64 low = m_engine() >> 6;
+    return ((high << 26) | low) * 0x1.0p-53;
+}
+
+QByteArray GameRandom::state() const {
+    std::ostringstream out;
+    out << m_engine;
+    return QByteArray::fromStdString(out.str());
+}
+
+bool GameRandom::restore(quint32 seed, const QByteArray &state) {
+    std::istringstream in(state.toStdString());
+    Engine engine;
+    in >> engine;
+    if(in.fail()) {
+        return false;
+    }
+    m_seed = seed;
+    m_engine = engine;
+    return true;
+}
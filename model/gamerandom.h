@@ -0,0 +1,95 @@
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <QByteArray>
+#include <random>
+
+/**
+ * @brief The GameRandom class is the random generator of the game, so a saved game goes on with the same dice.
+ * It is a seeded Mersenne Twister, the seed and the state are written to the save file.
+ * global() is the one of the game, only used on the GUI thread by the behaviors. A level is not made with it but with
+ * its own GameRandom seeded by levelSeed(), so a level generated on a worker thread does not take numbers from the game
+ * and is the same whenever it is generated.
+ */
+class GameRandom {
+public:
+    /**
+     * @brief Engine The generator, its state is the same on every platform.
+     */
+    using Engine = std::mt19937;
+
+    /**
+     * @brief global The generator of the game.
+     */
+    static GameRandom &global();
+
+    /**
+     * @brief seed Starts a new sequence.
+     * @param seed The seed of the game.
+     */
+    void seed(quint32 seed);
+
+    /**
+     * @brief gameSeed The seed the game was started with.
+     */
+    quint32 gameSeed() const {
+        return m_seed;
+    }
+
+    /**
+     * @brief levelSeed The seed a level is generated from, it only depends on the game seed and the level.
+     * @param level The level number.
+     */
+    quint32 levelSeed(int level) const {
+        return m_seed + 0x9E3779B9u * (quint32)(level + 1);
+    }
+
+    /**
+     * @brief bounded A number in [0, highest), like QRandomGenerator::bounded().
+     */
+    int bounded(int highest) {
+        return bounded(0, highest);
+    }
+
+    /**
+     * @brief bounded A number in [lowest, highest), lowest if the interval is empty.
+     */
+    int bounded(int lowest, int highest);
+
+    /**
+     * @brief generateDouble A number in [0, 1).
+     */
+    double generateDouble();
+
+    /**
+     * @brief engine The generator itself, for the standard distributions.
+     */
+    Engine &engine() {
+        return m_engine;
+    }
+
+    /**
+     * @brief state The state of the generator as text, what the standard library writes for the engine.
+     */
+    QByteArray state() const;
+
+    /**
+     * @brief restore Goes back to a saved point of a sequence.
+     * @param seed The seed of the game, from gameSeed().
+     * @param state The state, from state().
+     * @return False if the state could not be read, the generator is then not changed.
+     */
+    bool restore(quint32 seed, const QByteArray &state);
+
+private:
+    /**
+     * @brief m_seed The seed of the game.
+     */
+    quint32 m_seed = Engine::default_seed;
+    /**
+     * @brief m_engine The generator.
+     */
+    Engine m_engine;
+};
+
+#endif // GAMERANDOM_H
@@ -0,0 +1,50 @@
+#include "levelpregenerator.h"
+
+#include <QPromise>
+#include <QtConcurrent>
+
+void LevelPregenerator::prefetch(const LevelParameters &parameters) {
+    cancel();
+    m_parameters = parameters;
+    m_future = QtConcurrent::run([parameters](QPromise<LevelData> &promise) {
+        // A level cancelled before it got a thread is not built at all, one cancelled while it is built stops
+        // at the next stage, so it does not keep a thread of the pool busy.
+        if(promise.isCanceled()) {
+            return;
+        }
+        auto data = ObjectModelFactory::createLevelData(parameters, [&promise] { return promise.isCanceled(); });
+        if(!promise.isCanceled()) {
+            promise.addResult(std::move(data));
+        }
+    });
+}
+
+LevelData LevelPregenerator::take(const LevelParameters &parameters) {
+    if(m_future.isValid() && !m_future.isCanceled() && m_parameters == parameters) {
+        bool ready = m_future.isFinished();
+        m_future.waitForFinished();
+
+        // A prefetch that ended without a level is only counted as missed, below.
+        if(m_future.resultCount()) {
+            if(ready) {
+                m_stats.ready++;
+            } else {
+                m_stats.late++;
+            }
+            auto data = m_future.takeResult();
+            m_future = {};
+            return data;
+        }
+    }
+
+    m_stats.missed++;
+    cancel();
+    return ObjectModelFactory::createLevelData(parameters);
+}
+
+void LevelPregenerator::cancel() {
+    if(m_future.isValid()) {
+        m_future.cancel();
+        m_future = {};
+    }
+}
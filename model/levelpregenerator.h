@@ -0,0 +1,75 @@
+#ifndef LEVELPREGENERATOR_H
+#define LEVELPREGENERATOR_H
+
+#include <QFuture>
+
+#include "model/modelfactory.h"
+
+/**
+ * @brief The LevelPregenerator class builds the LevelData of the next level on a worker thread while the current
+ * level is played. The GameObjects are only made when the level is taken, on the thread that takes it,
+ * so the parenting of the QObjects stays on the GUI thread.
+ */
+class LevelPregenerator {
+public:
+    /**
+     * @brief The Stats struct counts how useful the prefetching was.
+     */
+    struct Stats {
+        /// The prefetched level was done when it was needed
+        int ready = 0;
+        /// The prefetched level was still being built and had to be waited for
+        int late = 0;
+        /// Nothing was prefetched for the level, it was built on the spot
+        int missed = 0;
+    };
+
+    /**
+     * @brief ~LevelPregenerator Cancels the level that is being built, if any.
+     */
+    ~LevelPregenerator() {
+        cancel();
+    }
+
+    /**
+     * @brief prefetch Starts building a level in the global thread pool. A previous prefetch is cancelled.
+     * @param parameters The level to build.
+     */
+    void prefetch(const LevelParameters &parameters);
+
+    /**
+     * @brief take Gets the data of a level. Waits for the prefetch if it is the same level and not done yet,
+     * otherwise the level is built on the calling thread.
+     * @param parameters The level to get.
+     * @return The level data, ready for ObjectModelFactory::createModel().
+     */
+    LevelData take(const LevelParameters &parameters);
+
+    /**
+     * @brief cancel Drops the prefetched level. If it is not started it never runs, otherwise it stops at its next check.
+     */
+    void cancel();
+
+    /**
+     * @brief stats How often the prefetch was ready in time.
+     */
+    const Stats &stats() const {
+        return m_stats;
+    }
+
+private:
+    /**
+     * @brief m_future The level being built.
+     */
+    QFuture<LevelData> m_future;
+    /**
+     * @brief m_parameters The parameters of the level being built.
+     */
+    LevelParameters m_parameters;
+    /**
+     * @brief m_stats The prefetch counters.
+     */
+    Stats m_stats;
+};
+
+#endif // LEVELPREGENERATOR_H
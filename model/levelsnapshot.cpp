@@ -0,0 +1,242 @@
+#include "levelsnapshot.h"
+
+#include <QtEndian>
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstring>
+
+namespace {
+/**
+ * @brief The SavedOccupant struct is the record of an occupant in a save file, one field per DataRole.
+ * Floats are stored as their bits.
+ */
+struct SavedOccupant {
+    quint32_le cell;
+    quint16_le present;
+    quint8 destroyed;
+    quint8 path;
+    qint32_le type;
+    qint32_le health;
+    quint32_le energy;
+    quint32_le strength;
+    qint32_le poisonLevel;
+    qint32_le fireLevel;
+    qint32_le x;
+    qint32_le y;
+    qint32_le direction;
+    qint32_le latestChange;
+    qint32_le changeDirection;
+    quint32_le id;
+};
+static_assert(sizeof(SavedOccupant) == 56, "The occupant record is part of the save format.");
+
+/// Header of a level in a save file
+struct SavedLevel {
+    qint32_le rows;
+    qint32_le columns;
+    quint32_le occupants;
+};
+
+/// Whether a saved type is one that stands on a tile, anything else would get the behaviors of another type
+bool isOccupantType(int type) {
+    // ObjectType is a char, a bigger value would wrap around to a valid one.
+    if(type < CHAR_MIN || type > CHAR_MAX) {
+        return false;
+    }
+    switch(static_cast<ObjectType>(type)) {
+    case ObjectType::Doorway:
+    case ObjectType::HealthPack:
+    case ObjectType::Protagonist:
+    case ObjectType::Enemy:
+    case ObjectType::PoisonEnemy:
+    case ObjectType::MovingEnemy:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Size of the poison array in a save file, padded so the records stay aligned
+qsizetype paddedSize(qsizetype size) {
+    return (size + 3) & ~qsizetype(3);
+}
+} // namespace
+
+LevelSnapshot LevelSnapshot::capture(const GameObjectModel &model, const QSharedPointer<PathWorkspace> &workspace) {
+    LevelSnapshot snapshot;
+    if(workspace) {
+        snapshot.m_costs = workspace->costs();
+        snapshot.m_clusters = workspace->clusters();
+    }
+    snapshot.m_rows = model.getRowCount();
+    snapshot.m_columns = model.getColumnCount();
+    snapshot.m_energy.reserve(snapshot.m_rows * snapshot.m_columns);
+    snapshot.m_poison.reserve(snapshot.m_rows * snapshot.m_columns);
+
+    // Read from the grid, the cold chunks of the level stay cold.
+    for(int y = 0; y < snapshot.m_rows; ++y) {
+        for(int x = 0; x < snapshot.m_columns; ++x) {
+            snapshot.m_energy.push_back(model.getTileData<DataRole::Energy>(x, y));
+            snapshot.m_poison.push_back(qBound(0, model.getTileData<DataRole::PoisonLevel>(x, y), 255));
+        }
+    }
+
+    model.forEachObject([&snapshot](QPoint position, const ObjectData &data) {
+        snapshot.m_occupants.push_back({quint32(position.y() * snapshot.m_columns + position.x()), data});
+    });
+    // The objects come chunk by chunk, they are kept in tile order.
+    std::stable_sort(snapshot.m_occupants.begin(), snapshot.m_occupants.end(), [](const Occupant &a, const Occupant &b) {
+        return a.cell < b.cell;
+    });
+    return snapshot;
+}
+
+QPair<GameObjectModel *, QSharedPointer<PathWorkspace>> LevelSnapshot::restore() const {
+    // The costs are only made again for snapshots read from a file.
+    QSharedPointer<CostGrid> costs;
+    if(!m_costs) {
+        costs = QSharedPointer<CostGrid>::create(m_columns, m_rows);
+    }
+    auto *model = new GameObjectModel(m_columns, m_rows);
+
+    for(int y = 0; y < m_rows; ++y) {
+        for(int x = 0; x < m_columns; ++x) {
+            int cell = y * m_columns + x;
+            if(costs) {
+                costs->setTerrain(x, y, m_energy[cell]);
+            }
+            model->setTerrain(x, y, m_energy[cell], m_poison[cell]);
+        }
+    }
+
+    for(const auto &occupant : m_occupants) {
+        // The id is given again by the model.
+        int x = occupant.cell % m_columns;
+        int y = occupant.cell / m_columns;
+        model->addObject(x, y, occupant.data);
+        if(costs) {
+            costs->addObject(x, y, occupant.data.get<DataRole::Type>());
+        }
+    }
+    model->updateChunks();
+
+    QSharedPointer<PathWorkspace> workspace;
+    if(m_costs) {
+        workspace = QSharedPointer<PathWorkspace>::create(m_costs, m_clusters);
+    } else {
+        workspace = QSharedPointer<PathWorkspace>::create(costs);
+        // The graph takes seconds on the biggest levels, the GUI thread does not wait for it.
+        if(workspace->hasClusters()) {
+            workspace->setClusters(ClusterGraph::buildLater(costs));
+        }
+    }
+    workspace->setLandmarks(LandmarkTable::buildLater(workspace->costs()));
+    return {model, workspace};
+}
+
+void LevelSnapshot::write(QByteArray &out) const {
+    qsizetype cells = m_energy.size();
+    qsizetype start = out.size();
+    out.resize(start + sizeof(SavedLevel) + cells * sizeof(float) + paddedSize(cells)
+               + m_occupants.size() * sizeof(SavedOccupant));
+    char *data = out.data() + start;
+
+    SavedLevel level {m_rows, m_columns, (quint32)m_occupants.size()};
+    std::memcpy(data, &level, sizeof(level));
+    data += sizeof(level);
+
+    qToLittleEndian<float>(m_energy.data(), cells, data);
+    data += cells * sizeof(float);
+    std::memcpy(data, m_poison.data(), cells);
+    std::memset(data + cells, 0, paddedSize(cells) - cells);
+    data += paddedSize(cells);
+
+    for(const auto &occupant : m_occupants) {
+        const ObjectData &d = occupant.data;
+        quint16 present = 0;
+        for(int i = 0; i < ObjectData::ROLE_COUNT; ++i) {
+            present |= d.contains(static_cast<DataRole>(i)) << i;
+        }
+        SavedOccupant record {occupant.cell,
+                              present,
+                              d.get<DataRole::Destroyed>(),
+                              d.get<DataRole::Path>(),
+                              (int)d.get<DataRole::Type>(),
+                              d.get<DataRole::Health>(),
+                              std::bit_cast<quint32>(d.get<DataRole::Energy>()),
+                              std::bit_cast<quint32>(d.get<DataRole::Strength>()),
+                              d.get<DataRole::PoisonLevel>(),
+                              d.get<DataRole::FireLevel>(),
+                              d.get<DataRole::Position>().x(),
+                              d.get<DataRole::Position>().y(),
+                              (int)d.get<DataRole::Direction>(),
+                              (int)d.get<DataRole::LatestChange>(),
+                              (int)d.get<DataRole::ChangeDirection>(),
+                              d.get<DataRole::Id>()};
+        std::memcpy(data, &record, sizeof(record));
+        data += sizeof(record);
+    }
+}
+
+bool LevelSnapshot::read(const uchar *&data, const uchar *end, LevelSnapshot &snapshot) {
+    SavedLevel level;
+    if(end - data < (qsizetype)sizeof(level)) {
+        return false;
+    }
+    std::memcpy(&level, data, sizeof(level));
+    data += sizeof(level);
+
+    qsizetype rows = level.rows, columns = level.columns;
+    // Checked before multiplying, a broken file could overflow the sizes below.
+    if(rows <= 0 || columns <= 0 || rows > SETTINGS::MAX_SIDE || columns > SETTINGS::MAX_SIDE) {
+        return false;
+    }
+    qsizetype cells = rows * columns;
+    if(end - data < cells * (qsizetype)sizeof(float) + paddedSize(cells)
+                         + (qsizetype)level.occupants * (qsizetype)sizeof(SavedOccupant)) {
+        return false;
+    }
+
+    snapshot.m_rows = rows;
+    snapshot.m_columns = columns;
+    snapshot.m_energy.resize(cells);
+    qFromLittleEndian<float>(data, cells, snapshot.m_energy.data());
+    data += cells * sizeof(float);
+    snapshot.m_poison.assign(data, data + cells);
+    data += paddedSize(cells);
+
+    snapshot.m_occupants.clear();
+    snapshot.m_occupants.reserve(level.occupants);
+    for(quint32 i = 0; i < level.occupants; ++i) {
+        SavedOccupant record;
+        std::memcpy(&record, data, sizeof(record));
+        data += sizeof(record);
+        if(record.cell >= cells || !(record.present & (1 << (int)DataRole::Type)) || !isOccupantType(record.type)) {
+            return false;
+        }
+
+        ObjectData d;
+        d.set<DataRole::Type>(static_cast<ObjectType>((int)record.type));
+        d.set<DataRole::Health>(record.health);
+        d.set<DataRole::Energy>(std::bit_cast<float>((quint32)record.energy));
+        d.set<DataRole::Strength>(std::bit_cast<float>((quint32)record.strength));
+        d.set<DataRole::PoisonLevel>(record.poisonLevel);
+        d.set<DataRole::FireLevel>(record.fireLevel);
+        d.set<DataRole::Destroyed>(record.destroyed);
+        d.set<DataRole::Position>(QPoint(record.x, record.y));
+        d.set<DataRole::Direction>(static_cast<Direction>((int)record.direction));
+        d.set<DataRole::LatestChange>(static_cast<DataRole>((int)record.latestChange));
+        d.set<DataRole::ChangeDirection>(static_cast<Direction>((int)record.changeDirection));
+        d.set<DataRole::Path>(record.path);
+        d.set<DataRole::Id>(record.id);
+        // Roles that were not set go back to not set.
+        for(int role = 0; role < ObjectData::ROLE_COUNT; ++role) {
+            if(!(record.present & (1 << role))) {
+                d.remove(static_cast<DataRole>(role));
+            }
+        }
+        snapshot.m_occupants.push_back({record.cell, d});
+    }
+    return true;
+}
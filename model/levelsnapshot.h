@@ -0,0 +1,115 @@
+#ifndef LEVELSNAPSHOT_H
+#define LEVELSNAPSHOT_H
+
+#include <algorithm>
+#include <vector>
+
+#include "model/gameobjectmodel.h"
+#include "model/objectdata.h"
+#include "model/pathfinding/pathworkspace.h"
+
+/**
+ * @brief The LevelSnapshot class is a compact copy of a level that is not being played, so its GameObjects can be freed.
+ * The tiles are two packed arrays (energy and poison) and everything standing on them is a flat list of typed data.
+ * Behaviors are not stored, restore() gives every object the behaviors of its type again, like the factory does.
+ * A snapshot of a level that was played keeps its CostGrid and ClusterGraph, they never change once built,
+ * so going back to the level does not build the graph again. They are not saved to files.
+ */
+class LevelSnapshot {
+public:
+    /// Snapshot settings
+    static const struct SETTINGS {
+        /// The longest side of a level, the biggest one the game makes (see GameWindow). Saves with bigger levels are not read.
+        static constexpr int MAX_SIDE = 2000;
+    } Settings;
+
+    /**
+     * @brief The Occupant struct is an object standing on a tile.
+     */
+    struct Occupant {
+        /// The cell of the tile, y * columns + x
+        quint32 cell;
+        /// The data of the object
+        ObjectData data;
+    };
+
+    /**
+     * @brief LevelSnapshot empty constructor, an empty level.
+     */
+    LevelSnapshot() = default;
+
+    /**
+     * @brief capture Copies a level, the model is not changed.
+     * @param model The level to copy.
+     * @param workspace The pathfinding workspace of the level, its costs and graph are kept. Null to keep none.
+     * @return The snapshot.
+     */
+    static LevelSnapshot capture(const GameObjectModel &model, const QSharedPointer<PathWorkspace> &workspace = {});
+
+    /**
+     * @brief restore Builds the level again. Makes the GameObjects, so it has to run on the GUI thread.
+     * Without the costs and graph of capture(), the ClusterGraph of a big level is built on a worker thread.
+     * @return A pair consisting of a pointer to the GameObjectModel and the PathWorkspace of the level.
+     */
+    QPair<GameObjectModel *, QSharedPointer<PathWorkspace>> restore() const;
+
+    /**
+     * @brief write Appends the snapshot to a save file. Layout, all little endian: rows, columns and the number
+     * of occupants as 32 bit integers, the energy array, the poison array padded to 4 bytes, then one fixed size
+     * record per occupant.
+     * @param out The save file being built.
+     */
+    void write(QByteArray &out) const;
+
+    /**
+     * @brief read Reads a snapshot written by write(). The tile arrays are copied in bulk, there is no per tile parsing.
+     * @param data The start of the snapshot, moved past it.
+     * @param end The end of the buffer.
+     * @param snapshot The snapshot to fill.
+     * @return False if the buffer is too short or the level makes no sense: a side bigger than SETTINGS::MAX_SIDE,
+     * an occupant outside of the level or of a type the game does not have.
+     */
+    static bool read(const uchar *&data, const uchar *end, LevelSnapshot &snapshot);
+
+    /**
+     * @brief count The number of occupants of a type.
+     */
+    qsizetype count(ObjectType type) const {
+        return std::count_if(m_occupants.begin(), m_occupants.end(), [type](const Occupant &occupant) {
+            return occupant.data.get<DataRole::Type>() == type;
+        });
+    }
+
+    /**
+     * @brief byteSize The memory used by the snapshot, without the object itself.
+     */
+    qsizetype byteSize() const {
+        return m_energy.size() * sizeof(float) + m_poison.size() * sizeof(quint8) + m_occupants.size() * sizeof(Occupant);
+    }
+
+private:
+    /**
+     * @brief m_rows, m_columns The size of the level.
+     */
+    int m_rows = 0;
+    int m_columns = 0;
+    /**
+     * @brief m_energy The energy of every tile, index y * columns + x.
+     */
+    std::vector<float> m_energy;
+    /**
+     * @brief m_poison The poison level of every tile, never above Poison::SETTINGS::MAX_POISON.
+     */
+    std::vector<quint8> m_poison;
+    /**
+     * @brief m_occupants Everything that stands on a tile, in tile order.
+     */
+    std::vector<Occupant> m_occupants;
+    /**
+     * @brief m_costs, m_clusters The pathfinding data of the level, null when read from a file.
+     */
+    QSharedPointer<const CostGrid> m_costs;
+    QSharedPointer<const ClusterGraph> m_clusters;
+};
+
+#endif // LEVELSNAPSHOT_H
@@ -0,0 +1,97 @@
+# The model of the game, it does not depend on the view or the controller.
+# Included by Game.pro and by the targets in tests/.
+
+QT += core gui concurrent
+
+INCLUDEPATH += $$PWD/..
+DEPENDPATH += $$PWD/..
+
+SOURCES += \
+    $$PWD/behaviors/attack.cpp \
+    $$PWD/behaviors/behavior.cpp \
+    $$PWD/behaviors/concrete/attack/counterattackbehavior.cpp \
+    $$PWD/behaviors/concrete/attack/genericattackbehavior.cpp \
+    $$PWD/behaviors/concrete/health/generichealingbehavior.cpp \
+    $$PWD/behaviors/concrete/health/generichealthbehavior.cpp \
+    $$PWD/behaviors/concrete/movement/genericmovebehavior.cpp \
+    $$PWD/behaviors/concrete/movement/genericwalkablebehavior.cpp \
+    $$PWD/behaviors/concrete/movement/healonstepbehavior.cpp \
+    $$PWD/behaviors/concrete/movement/newlevelonstep.cpp \
+    $$PWD/behaviors/concrete/movement/poisononstepbehavior.cpp \
+    $$PWD/behaviors/concrete/movement/randommovementbehavior.cpp \
+    $$PWD/behaviors/concrete/poison/genericpoisonablebehavior.cpp \
+    $$PWD/behaviors/concrete/health/poisononkilledbehavior.cpp \
+    $$PWD/behaviors/concrete/poison/genericpoisoningbehavior.cpp \
+    $$PWD/behaviors/health.cpp \
+    $$PWD/behaviors/movement.cpp \
+    $$PWD/behaviors/poison.cpp \
+    $$PWD/changejournal.cpp \
+    $$PWD/chunkmap.cpp \
+    $$PWD/distancefield.cpp \
+    $$PWD/entityregistry.cpp \
+    $$PWD/gameobject.cpp \
+    $$PWD/gameobjectmodel.cpp \
+    $$PWD/gamerandom.cpp \
+    $$PWD/levelpregenerator.cpp \
+    $$PWD/levelsnapshot.cpp \
+    $$PWD/modelfactory.cpp \
+    $$PWD/neighbortable.cpp \
+    $$PWD/noise/perlinnoise.cpp \
+    $$PWD/objectdata.cpp \
+    $$PWD/objectpool.cpp \
+    $$PWD/pathfinding/clustergraph.cpp \
+    $$PWD/pathfinding/costgrid.cpp \
+    $$PWD/pathfinding/dstarlite.cpp \
+    $$PWD/pathfinding/landmarktable.cpp \
+    $$PWD/pathfinding/pathservice.cpp \
+    $$PWD/pathfinding/pathworkspace.cpp \
+    $$PWD/savegame.cpp \
+    $$PWD/spatialindex.cpp \
+    $$PWD/tickscheduler.cpp \
+    $$PWD/worldgrid.cpp
+
+HEADERS += \
+    $$PWD/behaviors/attack.h \
+    $$PWD/behaviors/behavior.h \
+    $$PWD/behaviors/concrete/attack/counterattackbehavior.h \
+    $$PWD/behaviors/concrete/attack/genericattackbehavior.h \
+    $$PWD/behaviors/concrete/health/generichealingbehavior.h \
+    $$PWD/behaviors/concrete/health/generichealthbehavior.h \
+    $$PWD/behaviors/concrete/movement/genericmovebehavior.h \
+    $$PWD/behaviors/concrete/movement/genericwalkablebehavior.h \
+    $$PWD/behaviors/concrete/movement/healonstepbehavior.h \
+    $$PWD/behaviors/concrete/movement/newlevelonstep.h \
+    $$PWD/behaviors/concrete/movement/poisononstepbehavior.h \
+    $$PWD/behaviors/concrete/movement/randommovementbehavior.h \
+    $$PWD/behaviors/concrete/poison/genericpoisonablebehavior.h \
+    $$PWD/behaviors/concrete/health/poisononkilledbehavior.h \
+    $$PWD/behaviors/concrete/poison/genericpoisoningbehavior.h \
+    $$PWD/behaviors/health.h \
+    $$PWD/behaviors/movement.h \
+    $$PWD/behaviors/poison.h \
+    $$PWD/changejournal.h \
+    $$PWD/chunkmap.h \
+    $$PWD/distancefield.h \
+    $$PWD/entityregistry.h \
+    $$PWD/gameobject.h \
+    $$PWD/gameobjectmodel.h \
+    $$PWD/gamerandom.h \
+    $$PWD/gameobjectsettings.h \
+    $$PWD/levelpregenerator.h \
+    $$PWD/levelsnapshot.h \
+    $$PWD/modelfactory.h \
+    $$PWD/neighbortable.h \
+    $$PWD/noise/perlinnoise.h \
+    $$PWD/objectdata.h \
+    $$PWD/objectpool.h \
+    $$PWD/pathfinding/clustergraph.h \
+    $$PWD/pathfinding/costgrid.h \
+    $$PWD/pathfinding/dstarlite.h \
+    $$PWD/pathfinding/landmarktable.h \
+    $$PWD/pathfinding/pathservice.h \
+    $$PWD/pathfinding/pathworkspace.h \
+    $$PWD/savegame.h \
+    $$PWD/spatialindex.h \
+    $$PWD/tickscheduler.h \
+    $$PWD/worldgrid.h \
+    $$PWD/../publicenums.h
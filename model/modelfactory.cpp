@@ -1,127 +1,195 @@
-#include <QRandomGenerator>
-#include <QFile>
+#include <QImage>
+#include <cmath>
+#include <limits>
 
 #include "model/noise/perlinnoise.h"
 #include "gameobjectsettings.h"
 #include "modelfactory.h"
-#include "world.h"
 
-QPair<GameObjectModel *, std::vector<Node>> ObjectModelFactory::createModel(
+QPair<GameObjectModel *, QSharedPointer<PathWorkspace>> ObjectModelFactory::createModel(
   unsigned int nrOfEnemies, unsigned int nrOfHealthpacks,
-  float pRatio, int level, int rows, int columns) {
-    std::vector<Node> nodes; // Node class for the pathfinder
-    World m_world;
-
-    createWorld(columns, rows, (double)(level + 1) / 20.0);
-    m_world.createWorld("./world.png", nrOfEnemies, nrOfHealthpacks, pRatio);
-    QFile::remove("./world.png");
-
-    QList<QList<QPointer<GameObject>>> worldGrid(columns); // instantiate gameObjectModel aka the worldgrid
-    for(int i = 0; i < columns; ++i) {
-        worldGrid[i] = QList<QPointer<GameObject>>(rows);
-    }
-
-    // insert tiles into model
-    auto tiles = m_world.getTiles();
-    for(const auto &tile : tiles) {
-        nodes.emplace_back(tile->getXPos(), tile->getYPos(), tile->getValue());
-        auto *obj = new GameObject({
-          {DataRole::Energy, tile->getValue()},
-          {DataRole::Position, QPoint(tile->getXPos(), tile->getYPos())},
-        });
-        GameObjectSettings::getFunction(ObjectType::Tile)(obj);
-        worldGrid[tile->getXPos()][tile->getYPos()] = obj;
+  float pRatio, int level, int rows, int columns, quint32 seed) {
+    return createModel(createLevelData({level, nrOfEnemies, nrOfHealthpacks, pRatio, rows, columns, seed}));
+}
+
+LevelData ObjectModelFactory::createLevelData(const LevelParameters &parameters, const std::function<bool()> &isCanceled) {
+    LevelData data;
+    data.parameters = parameters;
+    int rows = parameters.rows;
+    int columns = parameters.columns;
+    // Everything random about the level comes from its seed, not from the generator of the game.
+    GameRandom random;
+    random.seed(parameters.seed);
+
+    // The heightmap goes straight to the tiles, there is no image file in between anymore.
+    auto &heightmap = data.heightmap;
+    heightmap = createHeightmap(columns, rows, (double)(parameters.level + 1) / 20.0, random);
+    if(SETTINGS::EXPORT_WORLD) {
+        createWorld(heightmap, columns, rows);
     }
-    // Process doorways
-    if(level) {
-        auto *entryDoor = new GameObject({
-          {DataRole::Direction, QVariant::fromValue<Direction>(Direction::Down)},
-        });
-        GameObjectSettings::getFunction(ObjectType::Doorway)(entryDoor);
-        entryDoor->setParent(worldGrid[0][0]);
-    }
-
-    auto *exitDoor = new GameObject({
-      {DataRole::Direction, QVariant::fromValue<Direction>(Direction::Up)},
-    });
-    GameObjectSettings::getFunction(ObjectType::Doorway)(exitDoor);
-    exitDoor->setParent(worldGrid[columns - 1][rows - 1]);
-
-    // Process protagonist
-    auto protagonist = m_world.getProtagonist();
-    auto *proObj = new GameObject();
-    GameObjectSettings::getFunction(ObjectType::Protagonist)(proObj);
-    proObj->setParent(worldGrid[protagonist->getXPos()][protagonist->getYPos()]);
+
+    if(isCanceled && isCanceled()) {
+        return data;
+    }
+
+    // The costs for the pathfinder
+    data.costs = QSharedPointer<CostGrid>::create(columns, rows);
+    auto &costs = *data.costs;
+    for(int y = 0; y < rows; ++y) {
+        for(int x = 0; x < columns; ++x) {
+            costs.setTerrain(x, y, heightmap[y * columns + x]);
+        }
+    }
+
+    // Process protagonist, it starts at the entry like it did in the World library.
+    data.placements.append({ObjectType::Protagonist, QPoint(0, 0)});
+
+    // Every cell that can still get something, the entry and the exit are kept free.
+    std::vector<quint32> candidates;
+    candidates.reserve(heightmap.size());
+    for(size_t cell = 1; cell + 1 < heightmap.size(); ++cell) {
+        if(!std::isinf(heightmap[cell])) {
+            candidates.push_back(cell);
+        }
+    }
+
+    // Pick the cells of the enemies before the ones of the health packs, like the World library did.
+    auto enemies = pickCells(candidates, columns, parameters.nrOfEnemies, random);
+    auto healthPacks = pickCells(candidates, columns, parameters.nrOfHealthpacks, random);
+
+    // The cells that already have something, a moving enemy goes on none of them.
+    std::vector<bool> taken(heightmap.size());
 
     // Process Health Packs
-    auto healthPacks = m_world.getHealthPacks();
     for(const auto &hp : healthPacks) {
-        auto *hpObj = new GameObject();
-        GameObjectSettings::getFunction(ObjectType::HealthPack)(hpObj);
-        nodes[hp->getYPos() * columns + hp->getXPos()].setValue(0.01);
-        hpObj->setParent(worldGrid[hp->getXPos()][hp->getYPos()]);
+        costs.addObject(hp.x(), hp.y(), ObjectType::HealthPack);
+        data.placements.append({ObjectType::HealthPack, hp});
+        taken[hp.y() * columns + hp.x()] = true;
     }
 
     // Process Enemies and Poison Enemies
-    auto enemies = m_world.getEnemies();
-    int enemyLocations[columns][rows];
-    memset(enemyLocations, 0, sizeof(enemyLocations));
+    for(const auto &enemy : enemies) {
+        ObjectType type = random.generateDouble() < parameters.pRatio ? ObjectType::PoisonEnemy : ObjectType::Enemy;
+        costs.addObject(enemy.x(), enemy.y(), type);
+        data.placements.append({type, enemy, random.bounded(0, 7) * 45});
+        taken[enemy.y() * columns + enemy.x()] = true;
+    }
 
+    // Moving enemies are placed diagonally next to an enemy, (x - 1, y - 1), away from the border.
+    // Only free cells that are not walls are candidates, and each of them only once.
+    std::vector<quint32> movingCells;
     for(const auto &enemy : enemies) {
-        int enemyX = enemy->getXPos();
-        int enemyY = enemy->getYPos();
-        enemyLocations[enemyX - 1][enemyY - 1] = 1;
-        if((enemyX == columns - 1 && enemyY == rows - 1) || (enemyX == 0 && enemyY == 0)) {
-            enemyX = columns - 2;
-            enemyY = rows - 2; // make sure no enemies on the doorway
+        int enemyX = enemy.x();
+        int enemyY = enemy.y();
+        if(enemyX > 1 && enemyX < columns - 1 && enemyY > 1 && enemyY < rows - 1) {
+            quint32 cell = (enemyY - 1) * columns + enemyX - 1;
+            if(!taken[cell] && !std::isinf(heightmap[cell])) {
+                taken[cell] = true;
+                movingCells.push_back(cell);
+            }
         }
+    }
+    for(const auto &cell : pickCells(movingCells, columns, SETTINGS::MOVING_ENEMIES, random)) {
+        data.placements.append({ObjectType::MovingEnemy, cell});
+    }
 
-        nodes[enemyY * columns + enemyX].setValue(0.8);
-
-        ObjectType type = dynamic_cast<PEnemy *>(enemy.get()) ? ObjectType::PoisonEnemy : ObjectType::Enemy;
-        auto *enemyObj = new GameObject();
-        GameObjectSettings::getFunction(type)(enemyObj);
-        enemyObj->setData(DataRole::Direction, QRandomGenerator::global()->bounded(0, 7) * 45);
-        enemyObj->setParent(worldGrid[enemyX][enemyY]);
+    if(isCanceled && isCanceled()) {
+        return data;
     }
 
-    // Moving enemies not placed in the same place as other enemies.
-    int movingEnemies = 5;
-    while(movingEnemies) {
-        auto *enemyObj = new GameObject();
-        GameObjectSettings::getFunction(ObjectType::MovingEnemy)(enemyObj);
-        int x = 0, y = 0;
-        do {
-            x = QRandomGenerator::global()->bounded(1, columns - 2);
-            y = QRandomGenerator::global()->bounded(1, rows - 2);
-        } while(!enemyLocations[x][y]);
-        enemyObj->setParent(worldGrid[x][y]);
-        movingEnemies--;
+    // Big levels get their pathfinding graph here, while the level is still being made off the GUI thread.
+    data.clusters = ClusterGraph::build(data.costs, isCanceled);
+    return data;
+}
+
+QPair<GameObjectModel *, QSharedPointer<PathWorkspace>> ObjectModelFactory::createModel(LevelData data) {
+    int rows = data.parameters.rows;
+    int columns = data.parameters.columns;
+    auto *model = new GameObjectModel(columns, rows); // instantiate gameObjectModel aka the worldgrid
+
+    // The tiles only go into the grid, their GameObjects are made by chunk.
+    for(int y = 0; y < rows; ++y) {
+        for(int x = 0; x < columns; ++x) {
+            model->setTerrain(x, y, data.heightmap[y * columns + x]);
+        }
+    }
+    // Process doorways
+    if(data.parameters.level) {
+        auto entryDoor = GameObjectSettings::getDefaultData(ObjectType::Doorway);
+        entryDoor.set<DataRole::Direction>(Direction::Down);
+        model->addObject(0, 0, entryDoor);
     }
 
-    auto *model = new GameObjectModel(worldGrid);
+    auto exitDoor = GameObjectSettings::getDefaultData(ObjectType::Doorway);
+    exitDoor.set<DataRole::Direction>(Direction::Up);
+    model->addObject(columns - 1, rows - 1, exitDoor);
 
-    return {model, nodes};
+    // The protagonist, health packs and enemies
+    for(const auto &placement : data.placements) {
+        auto object = GameObjectSettings::getDefaultData(placement.type);
+        if(placement.direction >= 0) {
+            object.set<DataRole::Direction>((Direction)placement.direction);
+        }
+        model->addObject(placement.position.x(), placement.position.y(), object);
+    }
+    model->updateChunks();
+
+    // The landmarks only speed the searches up, the level can be played before they are done.
+    auto workspace = QSharedPointer<PathWorkspace>::create(data.costs, data.clusters);
+    workspace->setLandmarks(LandmarkTable::buildLater(data.costs));
+    return {model, workspace};
 }
 
-void ObjectModelFactory::createWorld(int width, int height, double difficulty) {
-    QImage image(width, height, QImage::Format_Grayscale8);
-    int seed = floor(QRandomGenerator::global()->bounded(1, 1000));
+std::vector<float> ObjectModelFactory::createHeightmap(int width, int height, double difficulty, GameRandom &random) {
+    std::vector<float> heightmap(width * height);
+    int seed = random.bounded(1, 1000);
     PerlinNoise pn(seed);
-    for(int i = 0; i < height; ++i) { // y
-        auto pLine = image.scanLine(i);
 
-        for(int j = 0; j < width; ++j) { // x
-            double x = (double)j / ((double)width);
-            double y = (double)i / ((double)height);
-
-            // This makes it look a bit better, at least the noise is slightly stretched.
-            double n = 4 * pn.noise(x * width / 15, y * height / 30, 0.8);
+    // This makes it look a bit better, at least the noise is slightly stretched.
+    std::vector<double> xs(width), ys(height);
+    for(int j = 0; j < width; ++j) {
+        xs[j] = (double)j / ((double)width) * width / 15;
+    }
+    for(int i = 0; i < height; ++i) {
+        ys[i] = (double)i / ((double)height) * height / 30;
+    }
+    pn.noiseRows(xs.data(), width, ys.data(), height, 0.8, heightmap.data());
+
+    for(auto &value : heightmap) {
+        double n = 4 * value;
+        // Map the values to around the [0, 255] interval, will eventually be higher.
+        // Higher values wrap around like they did when they were written to the 8 bit image.
+        quint8 grey = (int)floor(255 * n * difficulty);
+        value = grey ? grey / 255.0f : std::numeric_limits<float>::infinity();
+    }
+    return heightmap;
+}
 
-            // Map the values to around the [0, 255] interval, will eventually be higher
-            *pLine++ = floor(255 * n * difficulty);
+void ObjectModelFactory::createWorld(const std::vector<float> &heightmap, int width, int height, const QString &fileName) {
+    QImage image(width, height, QImage::Format_Grayscale8);
+    for(int i = 0; i < height; ++i) {
+        auto pLine = image.scanLine(i);
+        for(int j = 0; j < width; ++j) {
+            float energy = heightmap[i * width + j];
+            *pLine++ = std::isinf(energy) ? 0 : qRound(energy * 255);
         }
     }
+    image.save(fileName, "png", -1);
+}
 
-    image.save("./world.png", "png", -1);
+QList<QPoint> ObjectModelFactory::pickCells(std::vector<quint32> &candidates, int width, unsigned int count,
+                                            GameRandom &random) {
+    // A picked cell is swapped with the last candidate and dropped, every pick takes the same time
+    // no matter how full the world is, and a cell can never be picked twice.
+    QList<QPoint> cells;
+    count = std::min<size_t>(count, candidates.size());
+    cells.reserve(count);
+    while(cells.size() < count) {
+        int index = random.bounded((int)candidates.size());
+        quint32 cell = candidates[index];
+        candidates[index] = candidates.back();
+        candidates.pop_back();
+        cells.append({int(cell % width), int(cell / width)});
+    }
+    return cells;
 }
@@ -4,34 +4,134 @@
 #define MODELFACTORY_H
 
 #include "gameobjectmodel.h"
-#include <node.h>
+#include "model/gamerandom.h"
+#include "model/pathfinding/pathworkspace.h"
+
+/**
+ * @brief The LevelParameters struct holds what a level is generated from.
+ */
+struct LevelParameters {
+    /// The level number, affects the world generation difficulty
+    int level = 0;
+    /// Number of enemies and health packs to place
+    unsigned int nrOfEnemies = 0;
+    unsigned int nrOfHealthpacks = 0;
+    /// The poison ratio, share of the enemies that are poison enemies
+    float pRatio = 0.5f;
+    /// Size of the world grid
+    int rows = 30;
+    int columns = 40;
+    /// The seed of the level, the same parameters always make the same level
+    quint32 seed = 0;
+
+    bool operator==(const LevelParameters &) const = default;
+};
+
+/**
+ * @brief The LevelData struct is a generated level before it becomes GameObjects. It has no QObjects,
+ * so it can be made on any thread and turned into a model later on the GUI thread.
+ */
+struct LevelData {
+    /**
+     * @brief The Placement struct is an object to put on a tile.
+     */
+    struct Placement {
+        ObjectType type;
+        QPoint position;
+        /// Direction the object looks in, -1 keeps the default of the type
+        int direction = -1;
+    };
+
+    /// The parameters the level was generated from
+    LevelParameters parameters;
+    /// The energy of every tile, index y * columns + x
+    std::vector<float> heightmap;
+    /// The costs for the pathfinder
+    QSharedPointer<CostGrid> costs;
+    /// The abstract graph for the pathfinder, null for small levels
+    QSharedPointer<const ClusterGraph> clusters;
+    /// Everything that is not a tile or a doorway, in the order it is placed
+    QList<Placement> placements;
+};
 
 /**
  * @brief The ObjectModelFactory class is responsible for creating and populating the game world model.
- * It includes methods to generate the game world grid and pathfinding nodes.
+ * It includes methods to generate the game world grid and the pathfinding costs.
  */
 class ObjectModelFactory {
 public:
     /**
-     * @brief Creates a game model consisting of a grid of GameObjects and pathfinding nodes.
+     * @brief Creates a game model consisting of a grid of GameObjects and the pathfinding workspace of the level.
      * @param nrOfEnemies The number of enemies to create.
      * @param nrOfHealthpacks The number of health packs to create.
      * @param pRatio The poison ratio, affects the generation of poison tiles/enemies.
      * @param level The current game level, affects the world generation difficulty.
      * @param rows The number of rows in the game world grid.
      * @param columns The number of columns in the game world grid.
-     * @return A pair consisting of a pointer to the generated GameObjectModel and a vector of Nodes for pathfinding.
+     * @param seed The seed of the level.
+     * @return A pair consisting of a pointer to the generated GameObjectModel and the PathWorkspace of the level.
      */
-    static QPair<GameObjectModel *, std::vector<Node>> createModel(unsigned int nrOfEnemies, unsigned int nrOfHealthpacks,
-                                                                   float pRatio, int level, int rows = 30, int columns = 40);
+    static QPair<GameObjectModel *, QSharedPointer<PathWorkspace>> createModel(unsigned int nrOfEnemies,
+                                                                              unsigned int nrOfHealthpacks, float pRatio,
+                                                                              int level, int rows = 30, int columns = 40,
+                                                                              quint32 seed = 0);
 
     /**
-     * @brief Generates a world image based on Perlin noise to simulate terrain. Used in world creation.
-     * @param width The width of the world (image) to generate.
-     * @param height The height of the world (image) to generate.
+     * @brief Turns generated level data into a game model. Makes the GameObjects, so it has to run on the GUI thread.
+     * @param data The level from createLevelData().
+     * @return A pair consisting of a pointer to the generated GameObjectModel and the PathWorkspace of the level.
+     */
+    static QPair<GameObjectModel *, QSharedPointer<PathWorkspace>> createModel(LevelData data);
+
+    /**
+     * @brief Generates a level: the terrain, the pathfinding costs and graph and where every object goes.
+     * @param parameters What to generate.
+     * @param isCanceled Returns true once the level is not wanted anymore. It is checked between the terrain,
+     * the placement and the graph and inside of ClusterGraph::build(). Empty for never.
+     * @return The level data, unfinished if it was cancelled.
+     */
+    static LevelData createLevelData(const LevelParameters &parameters, const std::function<bool()> &isCanceled = {});
+
+    /// Factory settings
+    static const struct SETTINGS {
+        /// Also save the heightmap of every level to ./world.png, for debugging the terrain.
+        static constexpr bool EXPORT_WORLD = false;
+        /// The number of moving enemies placed next to the other enemies.
+        static constexpr int MOVING_ENEMIES = 5;
+    } Settings;
+
+    /**
+     * @brief Generates the energy of every tile from Perlin noise to simulate terrain, row by row.
+     * The noise is mapped to a grey level like a world image, grey / 255 is the energy and black tiles are walls
+     * with infinite energy, the same values the World library read from the image.
+     * @param width The width of the world to generate.
+     * @param height The height of the world to generate.
      * @param difficulty The difficulty factor, influencing the generation of the Perlin noise terrain.
+     * @param random The generator of the level, it seeds the noise.
+     * @return The energies, index y * width + x.
+     */
+    static std::vector<float> createHeightmap(int width, int height, double difficulty, GameRandom &random);
+
+    /**
+     * @brief Saves a heightmap as a grayscale image. Only used as a debug export, levels are built in memory.
+     * @param heightmap The energies from createHeightmap().
+     * @param width The width of the world.
+     * @param height The height of the world.
+     * @param fileName The file to write.
+     */
+    static void createWorld(const std::vector<float> &heightmap, int width, int height,
+                            const QString &fileName = "./world.png");
+
+    /**
+     * @brief Picks random cells out of the candidates and removes them from the list.
+     * Every pick takes the same time, so placing n objects is O(n) however full the world gets.
+     * @param candidates The cells that can still be picked, the ones that are picked are removed.
+     * @param width The width of the world.
+     * @param count The number of cells to pick, less are returned if there are not enough candidates.
+     * @param random The generator of the level.
+     * @return The picked positions.
      */
-    static void createWorld(int width, int height, double difficulty = 1.0);
+    static QList<QPoint> pickCells(std::vector<quint32> &candidates, int width, unsigned int count, GameRandom &random);
 };
 
 #endif // MODELFACTORY_H
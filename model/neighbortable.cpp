@@ -0,0 +1,67 @@
+#include "neighbortable.h"
+
+#include <QMutex>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    /**
+     * @brief smallRingStart The index in SMALL_TABLE where the ring of an offset starts.
+     */
+    constexpr int smallRingStart(int offset) {
+        int start = 0;
+        for(int i = 0; i < offset; ++i) {
+            start += NeighborTable::ringSize(i);
+        }
+        return start;
+    }
+
+    /**
+     * @brief SMALL_TABLE The rings of the small offsets one after the other, built at compile time.
+     */
+    constexpr auto SMALL_TABLE = [] {
+        std::array<QPoint, smallRingStart(NeighborTable::SMALL_RINGS)> table {};
+        int k = 0;
+        for(int offset = 0; offset < NeighborTable::SMALL_RINGS; ++offset) {
+            for(double i = 0; i < 360; i += 360 / (((double)offset + 1) * 8)) {
+                table[k++] = NeighborTable::ringPoint(i, offset);
+            }
+        }
+        return table;
+    }();
+}
+
+std::span<const QPoint> NeighborTable::ring(int offset) {
+    if(offset < SMALL_RINGS) {
+        return std::span<const QPoint>(SMALL_TABLE).subspan(smallRingStart(offset), ringSize(offset));
+    }
+
+    // Nodes of an unordered_map do not move on rehash, so the spans handed out stay valid.
+    static QMutex mutex;
+    static std::unordered_map<int, std::vector<QPoint>> cache;
+
+    QMutexLocker locker(&mutex);
+    auto it = cache.find(offset);
+    if(it == cache.end()) {
+        std::vector<QPoint> points;
+        points.reserve(ringSize(offset));
+        for(double i = 0; i < 360; i += 360 / (((double)offset + 1) * 8)) {
+            points.push_back(ringPoint(i, offset));
+        }
+        it = cache.emplace(offset, std::move(points)).first;
+    }
+    return it->second;
+}
+
+bool NeighborTable::offset(double direction, int offset, QPoint *result) {
+    // Multiples of 45 deg land exactly on a corner or on the middle of a side, that is
+    // the unit vector of the direction scaled by the ring.
+    static constexpr QPoint COMPASS[] = {{1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+    if(direction < 0 || direction >= 360 || std::fmod(direction, 45) != 0) {
+        return false;
+    }
+    *result = COMPASS[static_cast<int>(direction) / 45] * (offset + 1);
+    return true;
+}
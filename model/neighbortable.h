@@ -0,0 +1,115 @@
+#ifndef NEIGHBORTABLE_H
+#define NEIGHBORTABLE_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <span>
+
+/**
+ * @brief The NeighborTable class holds the (dx, dy) offsets used by GameObjectModel::getNeighbor and
+ * GameObjectModel::getAllNeighbors. A neighbor at an angle is the point where a ray at that angle crosses
+ * the square ring of half size offset + 1, rounded to the grid. The y axis points down, 90 deg is up.
+ * The rings of the small offsets are computed at compile time, bigger ones are computed on first use and cached.
+ * The angles of a ring are generated exactly as getAllNeighbors always did, by adding 360 / (8 * (offset + 1))
+ * to a double, so the tables give the same tiles as the old QTransform/QLineF intersection.
+ */
+class NeighborTable {
+public:
+    /**
+     * @brief SMALL_RINGS The number of rings (offsets 0 to SMALL_RINGS - 1) computed at compile time.
+     */
+    static constexpr int SMALL_RINGS = 16;
+
+    /**
+     * @brief ring The offsets of all the neighbors at a given offset, in the order of increasing angle.
+     * @param offset The offset of the ring, 0 is the 8 closest tiles.
+     * @return The offsets, the span stays valid for the whole run of the program.
+     */
+    static std::span<const QPoint> ring(int offset);
+
+    /**
+     * @brief offset The offset of the neighbor at an angle.
+     * @param direction The angle in degrees.
+     * @param offset The offset of the ring.
+     * @param result Where the offset is written.
+     * @return False if the angle is not in the tables (it is not a multiple of 45 in [0, 360)),
+     * the caller then has to do the geometry itself.
+     */
+    static bool offset(double direction, int offset, QPoint *result);
+
+    /**
+     * @brief ringSize The number of angles getAllNeighbors visits for an offset.
+     * This is usually 8 * (offset + 1), the double accumulation can add one more angle just under 360.
+     */
+    static constexpr int ringSize(int offset) {
+        int size = 0;
+        for(double i = 0; i < 360; i += 360 / (((double)offset + 1) * 8)) {
+            ++size;
+        }
+        return size;
+    }
+
+    /**
+     * @brief ringPoint The neighbor offset at an angle, the ray/ring intersection rounded to the grid.
+     * @param direction The angle in degrees, in [0, 360).
+     * @param offset The offset of the ring.
+     * @return The (dx, dy) of the neighbor.
+     */
+    static constexpr QPoint ringPoint(double direction, int offset) {
+        double q = offset + 1;
+        double s = 0, c = 0;
+        sinCos(direction, s, c);
+        double ac = c < 0 ? -c : c;
+        double as = s < 0 ? -s : s;
+        // The side of the square the ray hits is the one of the biggest component.
+        // The y axis points down, so the y component is -sin.
+        if(ac >= as) {
+            return QPoint(qRound(c < 0 ? -q : q), qRound(-s * q / ac));
+        }
+        return QPoint(qRound(c * q / as), qRound(s < 0 ? q : -q));
+    }
+
+private:
+    /**
+     * @brief sinCos Compile time sine and cosine of an angle in degrees in [0, 360).
+     * The angle is reduced to the first quadrant in degrees, then a Taylor series is used.
+     */
+    static constexpr void sinCos(double degrees, double &s, double &c) {
+        constexpr double PI = 3.14159265358979323846;
+        int quadrant = 0;
+        while(degrees >= 90) {
+            degrees -= 90;
+            ++quadrant;
+        }
+        double x = degrees * (PI / 180);
+        double x2 = x * x;
+        double ts = x, tc = 1;
+        double sum_s = x, sum_c = 1;
+        for(int n = 1; n < 15; ++n) {
+            ts *= -x2 / ((2 * n) * (2 * n + 1));
+            tc *= -x2 / ((2 * n - 1) * (2 * n));
+            sum_s += ts;
+            sum_c += tc;
+        }
+        switch(quadrant) {
+        case 0:
+            s = sum_s;
+            c = sum_c;
+            break;
+        case 1:
+            s = sum_c;
+            c = -sum_s;
+            break;
+        case 2:
+            s = -sum_s;
+            c = -sum_c;
+            break;
+        default:
+            s = -sum_c;
+            c = sum_s;
+            break;
+        }
+    }
+};
+
+#endif // NEIGHBORTABLE_H
@@ -1,8 +1,14 @@
 #include "perlinnoise.h"
+#include <QSemaphore>
+#include <QThreadPool>
 #include <cmath>
 #include <random>
 #include <algorithm>
 #include <numeric>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
 /**
  * Obtained from: https://github.com/DeiVadder/QNoise
  *
@@ -87,15 +93,15 @@ double PerlinNoise::noise(double x, double y, double z) {
     return (res + 1.0) / 2.0;
 }
 
-double PerlinNoise::fade(double t) {
+double PerlinNoise::fade(double t) const {
     return t * t * t * (t * (t * 6 - 15) + 10);
 }
 
-double PerlinNoise::lerp(double t, double a, double b) {
+double PerlinNoise::lerp(double t, double a, double b) const {
     return a + t * (b - a);
 }
 
-double PerlinNoise::grad(int hash, double x, double y, double z) {
+double PerlinNoise::grad(int hash, double x, double y, double z) const {
     int h = hash & 15;
     // Convert lower 4 bits of hash into 12 gradient directions
     double u = h < 8 ? x : y,
@@ -103,3 +109,178 @@ double PerlinNoise::grad(int hash, double x, double y, double z) {
                                               : z;
     return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
 }
+
+// THE BATCH FUNCTIONS BELOW ARE NOT PART OF THE REFERENCE IMPLEMENTATION.
+// In a row y and z are fixed, so inside one unit cube the eight gradients are fixed too. Every corner
+// is then linear in x and the blend of the corners reduces to P * x + Q + fade(x) * (R * x + S).
+// The hashes are done once per cube and only that polynomial is evaluated per sample.
+
+namespace {
+/// Coefficients of the noise of the samples of one unit cube, x is the floor of the cube.
+struct Cell {
+    double x, p, q, r, s;
+};
+
+/// The gradient of grad() as coefficients of x, y and z.
+struct Gradient {
+    double x = 0, y = 0, z = 0;
+};
+
+Gradient gradient(int hash) {
+    int h = hash & 15;
+    Gradient g;
+    double u = (h & 1) == 0 ? 1 : -1;
+    double v = (h & 2) == 0 ? 1 : -1;
+    (h < 8 ? g.x : g.y) += u;
+    (h < 4 ? g.y : h == 12 || h == 14 ? g.x : g.z) += v;
+    return g;
+}
+
+inline void runScalar(const Cell &c, const double *xs, int count, double *out) {
+    for(int i = 0; i < count; ++i) {
+        double x = xs[i] - c.x;
+        double u = x * x * x * (x * (x * 6 - 15) + 10);
+        out[i] = (c.p * x + c.q + u * (c.r * x + c.s) + 1.0) * 0.5;
+    }
+}
+
+#if defined(__SSE2__) || defined(_M_X64)
+void runSse2(const Cell &c, const double *xs, int count, double *out) {
+    const __m128d cx = _mm_set1_pd(c.x), p = _mm_set1_pd(c.p), q = _mm_set1_pd(c.q);
+    const __m128d r = _mm_set1_pd(c.r), s = _mm_set1_pd(c.s);
+    const __m128d six = _mm_set1_pd(6), fifteen = _mm_set1_pd(15), ten = _mm_set1_pd(10);
+    const __m128d one = _mm_set1_pd(1), half = _mm_set1_pd(0.5);
+    int i = 0;
+    for(; i + 2 <= count; i += 2) {
+        __m128d x = _mm_sub_pd(_mm_loadu_pd(xs + i), cx);
+        __m128d u = _mm_add_pd(_mm_mul_pd(x, _mm_sub_pd(_mm_mul_pd(x, six), fifteen)), ten);
+        u = _mm_mul_pd(_mm_mul_pd(_mm_mul_pd(x, x), x), u);
+        __m128d res = _mm_add_pd(_mm_add_pd(_mm_mul_pd(p, x), q), _mm_mul_pd(u, _mm_add_pd(_mm_mul_pd(r, x), s)));
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_add_pd(res, one), half));
+    }
+    runScalar(c, xs + i, count - i, out + i);
+}
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PERLIN_HAS_AVX2
+__attribute__((target("avx2"))) void runAvx2(const Cell &c, const double *xs, int count, double *out) {
+    const __m256d cx = _mm256_set1_pd(c.x), p = _mm256_set1_pd(c.p), q = _mm256_set1_pd(c.q);
+    const __m256d r = _mm256_set1_pd(c.r), s = _mm256_set1_pd(c.s);
+    const __m256d six = _mm256_set1_pd(6), fifteen = _mm256_set1_pd(15), ten = _mm256_set1_pd(10);
+    const __m256d one = _mm256_set1_pd(1), half = _mm256_set1_pd(0.5);
+    int i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m256d x = _mm256_sub_pd(_mm256_loadu_pd(xs + i), cx);
+        __m256d u = _mm256_add_pd(_mm256_mul_pd(x, _mm256_sub_pd(_mm256_mul_pd(x, six), fifteen)), ten);
+        u = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(x, x), x), u);
+        __m256d res = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(p, x), q),
+                                    _mm256_mul_pd(u, _mm256_add_pd(_mm256_mul_pd(r, x), s)));
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_add_pd(res, one), half));
+    }
+    // The tail is inlined here, so it is compiled with AVX2 too and the lanes do not switch instruction sets.
+    runScalar(c, xs + i, count - i, out + i);
+}
+#endif
+
+using RunFunction = void (*)(const Cell &, const double *, int, double *);
+
+/// Picks the widest kernel the CPU supports, once.
+RunFunction selectRun() {
+#ifdef PERLIN_HAS_AVX2
+    if(__builtin_cpu_supports("avx2")) {
+        return runAvx2;
+    }
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+    return runSse2;
+#else
+    return runScalar;
+#endif
+}
+} // namespace
+
+void PerlinNoise::noiseRow(double y, double z, const double *xs, int count, double *out) const {
+    static const RunFunction run = selectRun();
+
+    // Same as noise(), for the coordinates that do not change in the row
+    int Y = (int)floor(y) & 255;
+    int Z = (int)floor(z) & 255;
+    y -= floor(y);
+    z -= floor(z);
+    double v = fade(y);
+    double w = fade(z);
+
+    // Weight of each edge along x in the blend: (y0, z0), (y1, z0), (y0, z1), (y1, z1)
+    const double weight[4] = {(1 - v) * (1 - w), v * (1 - w), (1 - v) * w, v * w};
+    const double dy[4] = {y, y - 1, y, y - 1};
+    const double dz[4] = {z, z, z - 1, z - 1};
+
+    for(int i = 0; i < count;) {
+        // Samples in the same cube are next to each other in a scanline
+        double cube = floor(xs[i]);
+        int end = i + 1;
+        while(end < count && xs[end] >= cube && xs[end] < cube + 1) {
+            ++end;
+        }
+
+        // Hash coordinates of the 8 cube corners
+        int X = (int)cube & 255;
+        int A = p[X] + Y;
+        int AA = p[A] + Z;
+        int AB = p[A + 1] + Z;
+        int B = p[X + 1] + Y;
+        int BA = p[B] + Z;
+        int BB = p[B + 1] + Z;
+        const int low[4] = {p[AA], p[AB], p[AA + 1], p[AB + 1]};
+        const int high[4] = {p[BA], p[BB], p[BA + 1], p[BB + 1]};
+
+        Cell cell {cube, 0, 0, 0, 0};
+        for(int edge = 0; edge < 4; ++edge) {
+            Gradient g0 = gradient(low[edge]);
+            Gradient g1 = gradient(high[edge]);
+            // The corners are g0.x * x + b0 and g1.x * x + b1, lerp(u, n0, n1) = n0 + u * (n1 - n0)
+            double b0 = g0.y * dy[edge] + g0.z * dz[edge];
+            double b1 = g1.y * dy[edge] + g1.z * dz[edge] - g1.x;
+            cell.p += weight[edge] * g0.x;
+            cell.q += weight[edge] * b0;
+            cell.r += weight[edge] * (g1.x - g0.x);
+            cell.s += weight[edge] * (b1 - b0);
+        }
+
+        run(cell, xs + i, end - i, out + i);
+        i = end;
+    }
+}
+
+void PerlinNoise::noiseRows(const double *xs, int width, const double *ys, int height, double z, float *out) const {
+    auto fillRows = [=, this](int first, int last) {
+        std::vector<double> row(width);
+        for(int i = first; i < last; ++i) {
+            noiseRow(ys[i], z, xs, width, row.data());
+            std::copy(row.begin(), row.end(), out + (size_t)i * width);
+        }
+    };
+
+    auto *pool = QThreadPool::globalInstance();
+    int chunks = std::clamp((int)((size_t)width * height / MIN_SAMPLES_PER_TASK), 1, std::max(1, pool->maxThreadCount()));
+
+    // Chunks that do not get a free thread right away run here. Waiting in line on a busy pool
+    // could deadlock when this is called from a pool thread itself.
+    QSemaphore done;
+    int started = 0;
+    for(int chunk = 1; chunk < chunks; ++chunk) {
+        int first = height * chunk / chunks;
+        int last = height * (chunk + 1) / chunks;
+        if(pool->tryStart([&fillRows, &done, first, last] {
+               fillRows(first, last);
+               done.release();
+           })) {
+            ++started;
+        } else {
+            fillRows(first, last);
+        }
+    }
+    fillRows(0, height / chunks);
+    done.acquire(started);
+}
@@ -24,11 +24,20 @@ public:
     PerlinNoise(unsigned int seed);
     /// Get a noise value, for 2D images z can have any value
     double noise(double x, double y, double z);
+    /// Get the noise of a whole scanline at once, out[i] is noise(xs[i], y, z) up to rounding.
+    /// Samples in the same unit cube share their hashes and are evaluated in SIMD lanes.
+    void noiseRow(double y, double z, const double *xs, int count, double *out) const;
+    /// Fill a grid row by row, out[i * width + j] is noise(xs[j], ys[i], z) in float precision.
+    /// Big grids are split in scanlines across the global QThreadPool.
+    void noiseRows(const double *xs, int width, const double *ys, int height, double z, float *out) const;
 
 private:
-    double fade(double t);
-    double lerp(double t, double a, double b);
-    double grad(int hash, double x, double y, double z);
+    /// Grids with less samples per thread than this are not worth splitting
+    static constexpr int MIN_SAMPLES_PER_TASK = 1 << 16;
+
+    double fade(double t) const;
+    double lerp(double t, double a, double b) const;
+    double grad(int hash, double x, double y, double z) const;
 };
 
 #endif
@@ -0,0 +1,151 @@
+#include "objectdata.h"
+
+ObjectData::ObjectData(const QMap<DataRole, QVariant> &data) {
+    for(auto it = data.cbegin(); it != data.cend(); ++it) {
+        setValue(it.key(), it.value());
+    }
+}
+
+void ObjectData::remove(DataRole role) {
+    // Reset the slot as well, get<>() on a missing role has to behave like QVariant().value<T>().
+    switch(role) {
+    case DataRole::Type:
+        set<DataRole::Type>({});
+        break;
+    case DataRole::Health:
+        set<DataRole::Health>({});
+        break;
+    case DataRole::Energy:
+        set<DataRole::Energy>({});
+        break;
+    case DataRole::Strength:
+        set<DataRole::Strength>({});
+        break;
+    case DataRole::PoisonLevel:
+        set<DataRole::PoisonLevel>({});
+        break;
+    case DataRole::FireLevel:
+        set<DataRole::FireLevel>({});
+        break;
+    case DataRole::Destroyed:
+        set<DataRole::Destroyed>({});
+        break;
+    case DataRole::Position:
+        set<DataRole::Position>({});
+        break;
+    case DataRole::Direction:
+        set<DataRole::Direction>({});
+        break;
+    case DataRole::LatestChange:
+        set<DataRole::LatestChange>({});
+        break;
+    case DataRole::ChangeDirection:
+        set<DataRole::ChangeDirection>({});
+        break;
+    case DataRole::Path:
+        set<DataRole::Path>({});
+        break;
+    case DataRole::Id:
+        set<DataRole::Id>({});
+        break;
+    }
+    m_present &= ~bit(role);
+}
+
+QVariant ObjectData::value(DataRole role) const {
+    if(!contains(role)) {
+        return QVariant();
+    }
+
+    switch(role) {
+    case DataRole::Type:
+        return QVariant::fromValue<ObjectType>(get<DataRole::Type>());
+    case DataRole::Health:
+        return get<DataRole::Health>();
+    case DataRole::Energy:
+        return get<DataRole::Energy>();
+    case DataRole::Strength:
+        return get<DataRole::Strength>();
+    case DataRole::PoisonLevel:
+        return get<DataRole::PoisonLevel>();
+    case DataRole::FireLevel:
+        return get<DataRole::FireLevel>();
+    case DataRole::Destroyed:
+        return get<DataRole::Destroyed>();
+    case DataRole::Position:
+        return get<DataRole::Position>();
+    case DataRole::Direction:
+        return QVariant::fromValue<Direction>(get<DataRole::Direction>());
+    case DataRole::LatestChange:
+        return QVariant::fromValue<DataRole>(get<DataRole::LatestChange>());
+    case DataRole::ChangeDirection:
+        return QVariant::fromValue<Direction>(get<DataRole::ChangeDirection>());
+    case DataRole::Path:
+        return get<DataRole::Path>();
+    case DataRole::Id:
+        return get<DataRole::Id>();
+    }
+    return QVariant();
+}
+
+void ObjectData::setValue(DataRole role, const QVariant &value) {
+    // Same as storing a null QVariant in the old map, getData(role).isNull() is used to
+    // check if an object has a ceirtain property.
+    if(!value.isValid()) {
+        remove(role);
+        return;
+    }
+
+    switch(role) {
+    case DataRole::Type:
+        set<DataRole::Type>(value.value<ObjectType>());
+        break;
+    case DataRole::Health:
+        set<DataRole::Health>(value.toInt());
+        break;
+    case DataRole::Energy:
+        set<DataRole::Energy>(value.toFloat());
+        break;
+    case DataRole::Strength:
+        set<DataRole::Strength>(value.toFloat());
+        break;
+    case DataRole::PoisonLevel:
+        set<DataRole::PoisonLevel>(value.toInt());
+        break;
+    case DataRole::FireLevel:
+        set<DataRole::FireLevel>(value.toInt());
+        break;
+    case DataRole::Destroyed:
+        set<DataRole::Destroyed>(value.toBool());
+        break;
+    case DataRole::Position:
+        set<DataRole::Position>(value.toPoint());
+        break;
+    case DataRole::Direction:
+        set<DataRole::Direction>(value.value<Direction>());
+        break;
+    case DataRole::LatestChange:
+        set<DataRole::LatestChange>(value.value<DataRole>());
+        break;
+    case DataRole::ChangeDirection:
+        set<DataRole::ChangeDirection>(value.value<Direction>());
+        break;
+    case DataRole::Path:
+        set<DataRole::Path>(value.toBool());
+        break;
+    case DataRole::Id:
+        set<DataRole::Id>(value.toUInt());
+        break;
+    }
+}
+
+QMap<DataRole, QVariant> ObjectData::toMap() const {
+    QMap<DataRole, QVariant> map;
+    for(int i = 0; i < ROLE_COUNT; ++i) {
+        auto role = static_cast<DataRole>(i);
+        if(contains(role)) {
+            map.insert(role, value(role));
+        }
+    }
+    return map;
+}
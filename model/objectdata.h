@@ -0,0 +1,132 @@
+#ifndef OBJECTDATA_H
+#define OBJECTDATA_H
+
+#include <QMap>
+#include <QPoint>
+#include <QVariant>
+#include <tuple>
+
+#include "publicenums.h"
+
+/**
+ * @brief The ObjectData class stores the data of a GameObject in typed slots, one per DataRole.
+ * The slots follow the order of the DataRole enum, so the hot paths can read a role with
+ * get<DataRole::Energy>() without a map lookup or a QVariant conversion. The QVariant functions
+ * are kept so everything that works with QMap<DataRole, QVariant> (the view, the controller) does not change.
+ */
+class ObjectData {
+public:
+    /**
+     * @brief Slots The type stored for each DataRole, in the same order as the enum.
+     */
+    using Slots = std::tuple<ObjectType, // Type
+                             int,        // Health
+                             float,      // Energy
+                             float,      // Strength
+                             int,        // PoisonLevel
+                             int,        // FireLevel
+                             bool,       // Destroyed
+                             QPoint,     // Position
+                             Direction,  // Direction
+                             DataRole,   // LatestChange
+                             Direction,  // ChangeDirection
+                             bool,       // Path
+                             quint32>;   // Id
+
+    /**
+     * @brief RoleType The type stored for a DataRole.
+     */
+    template <DataRole R>
+    using RoleType = std::tuple_element_t<static_cast<int>(R), Slots>;
+
+    /**
+     * @brief ROLE_COUNT The number of DataRoles with a slot.
+     */
+    static constexpr int ROLE_COUNT = std::tuple_size_v<Slots>;
+    static_assert(ROLE_COUNT == static_cast<int>(DataRole::Id) + 1, "Every DataRole needs a typed slot.");
+
+    /**
+     * @brief ObjectData empty constructor, no role is set.
+     */
+    ObjectData() = default;
+
+    /**
+     * @brief ObjectData constructor from a map of data, used by the compatibility API.
+     * @param data The roles and values to store.
+     */
+    ObjectData(const QMap<DataRole, QVariant> &data);
+
+    /**
+     * @brief get Reads a role at compile time. Roles that are not set return the default value of their type.
+     * @return The value stored for the role.
+     */
+    template <DataRole R>
+    RoleType<R> get() const {
+        return std::get<static_cast<int>(R)>(m_slots);
+    }
+
+    /**
+     * @brief set Writes a role at compile time and marks it as set.
+     * @param value The new value.
+     */
+    template <DataRole R>
+    void set(RoleType<R> value) {
+        std::get<static_cast<int>(R)>(m_slots) = value;
+        m_present |= bit(R);
+    }
+
+    /**
+     * @brief contains Checks if a role has been set.
+     * @param role The role to check.
+     * @return True if the role has a value.
+     */
+    bool contains(DataRole role) const {
+        return m_present & bit(role);
+    }
+
+    /**
+     * @brief remove Unsets a role and resets its slot to the default value.
+     * @param role The role to remove.
+     */
+    void remove(DataRole role);
+
+    /**
+     * @brief value Compatibility getter, wraps the slot in a QVariant.
+     * @param role The role to read.
+     * @return The value, or an invalid QVariant if the role is not set.
+     */
+    QVariant value(DataRole role) const;
+
+    /**
+     * @brief setValue Compatibility setter, converts the QVariant into the type of the slot.
+     * An invalid QVariant unsets the role.
+     * @param role The role to write.
+     * @param value The new value.
+     */
+    void setValue(DataRole role, const QVariant &value);
+
+    /**
+     * @brief toMap Builds the QMap representation with all the roles that are set.
+     * @return A map of the roles to their values.
+     */
+    QMap<DataRole, QVariant> toMap() const;
+
+private:
+    /**
+     * @brief bit The bit of a role in m_present.
+     */
+    static constexpr quint16 bit(DataRole role) {
+        return quint16(1u << static_cast<int>(role));
+    }
+
+    /**
+     * @brief m_slots The typed values.
+     */
+    Slots m_slots {};
+    /**
+     * @brief m_present Bit mask of the roles that are set.
+     */
+    quint16 m_present = 0;
+};
+
+#endif // OBJECTDATA_H
@@ -0,0 +1,55 @@
+#include "objectpool.h"
+
+#include <new>
+
+ObjectPool::ObjectPool(std::size_t objectSize)
+    : m_blockSize((sizeof(Header) + objectSize + alignof(Header) - 1) / alignof(Header) * alignof(Header)) {
+}
+
+void *ObjectPool::allocate(std::size_t size, ObjectPool *pool) {
+    Header *header = nullptr;
+    if(!pool) {
+        header = static_cast<Header *>(::operator new(sizeof(Header) + size));
+    } else {
+        // A bigger object would run into the next block, in release builds too.
+        if(sizeof(Header) + size > pool->m_blockSize) {
+            qFatal("ObjectPool: an object of %zu bytes does not fit in blocks of %zu bytes", size, pool->m_blockSize);
+        }
+        if(pool->m_free) {
+            header = reinterpret_cast<Header *>(pool->m_free);
+            pool->m_free = pool->m_free->next;
+        } else {
+            if(pool->m_next == pool->m_end) {
+                // One heap allocation for the next SLAB_BLOCKS objects, new[] aligns like the header needs.
+                std::size_t slabSize = pool->m_blockSize * SETTINGS::SLAB_BLOCKS;
+                pool->m_slabs.emplace_back(new std::byte[slabSize]);
+                pool->m_next = pool->m_slabs.back().get();
+                pool->m_end = pool->m_next + slabSize;
+            }
+            header = reinterpret_cast<Header *>(pool->m_next);
+            pool->m_next += pool->m_blockSize;
+        }
+        ++pool->m_live;
+    }
+
+    header->pool = pool;
+    return header + 1;
+}
+
+void ObjectPool::release(void *object) {
+    if(!object) {
+        return;
+    }
+
+    auto *header = static_cast<Header *>(object) - 1;
+    ObjectPool *pool = header->pool;
+    if(!pool) {
+        ::operator delete(header);
+        return;
+    }
+
+    auto *block = reinterpret_cast<FreeBlock *>(header);
+    block->next = pool->m_free;
+    pool->m_free = block;
+    --pool->m_live;
+}
@@ -0,0 +1,113 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <QtGlobal>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief The ObjectPool class hands out fixed size blocks of memory carved from big slabs, so making the
+ * GameObjects of a level is not one heap allocation each. A freed block goes on a free list and is reused
+ * by the next object, and all the slabs are freed at once when the pool is destroyed.
+ * Only the memory of the objects themselves is pooled. Every GameObject is a QObject, and Qt still allocates its
+ * private data and its list of children on the heap. A level is not torn down any faster either:
+ * ~GameObjectModel still deletes the GameObjects one by one, because each one has to run its destructor and
+ * free what Qt allocated for it. Only the last step, giving the blocks back, becomes a few slab frees.
+ * Every block starts with a small header that points to its pool, so a block can be given back without
+ * knowing where it came from. Blocks of objects made without a pool come from the heap, with the same header.
+ * A pool is not thread safe, the GameObjects of a level are only made on the GUI thread.
+ * The behaviors are not pooled. The tiles, nearly all of the objects, share theirs through Behavior::shared() and
+ * make none, so only the protagonist, the enemies and the health packs make their own, one allocation each with
+ * QSharedPointer::create. Those are on about one tile in twenty, pooling them would take a pool per behavior type
+ * and a custom deleter for every QSharedPointer.
+ */
+class ObjectPool {
+public:
+    /// Pool settings
+    static const struct SETTINGS {
+        /// The number of blocks in a slab.
+        static constexpr int SLAB_BLOCKS = 1024;
+    } Settings;
+
+    /**
+     * @brief ObjectPool constructor, the first slab is only allocated when the first block is needed.
+     * @param objectSize The size of the objects, every block fits one object and its header.
+     */
+    explicit ObjectPool(std::size_t objectSize);
+
+    ///@{
+    /// A pool owns its slabs, it can not be copied.
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+    ///@}
+
+    /**
+     * @brief allocate Gets the memory for an object, from the pool if there is one or from the heap otherwise.
+     * @param size The size of the object.
+     * @param pool The pool, or null.
+     * @return The memory for the object, aligned like operator new.
+     */
+    static void *allocate(std::size_t size, ObjectPool *pool);
+
+    /**
+     * @brief release Gives back the memory of an object made with allocate(), to its pool or to the heap.
+     * @param object The memory of the object.
+     */
+    static void release(void *object);
+
+    /**
+     * @brief liveCount The number of blocks that are in use.
+     */
+    int liveCount() const {
+        return m_live;
+    }
+
+    /**
+     * @brief slabCount The number of slabs, every one of them was a single heap allocation.
+     */
+    int slabCount() const {
+        return m_slabs.size();
+    }
+
+private:
+    /**
+     * @brief The Header struct is at the start of every block, the object comes right after it.
+     */
+    struct alignas(std::max_align_t) Header {
+        /// The pool of the block, null for blocks from the heap
+        ObjectPool *pool;
+    };
+
+    /**
+     * @brief The FreeBlock struct is a block on the free list, it is stored in the block itself.
+     */
+    struct FreeBlock {
+        /// The next free block
+        FreeBlock *next;
+    };
+
+    /**
+     * @brief m_blockSize The size of a block, header included, a multiple of the alignment.
+     */
+    std::size_t m_blockSize;
+    /**
+     * @brief m_slabs The memory of the pool.
+     */
+    std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+    /**
+     * @brief m_free The blocks that were given back.
+     */
+    FreeBlock *m_free = nullptr;
+    /**
+     * @brief m_next, m_end The part of the last slab that was never used.
+     */
+    std::byte *m_next = nullptr;
+    std::byte *m_end = nullptr;
+    /**
+     * @brief m_live The number of blocks in use.
+     */
+    int m_live = 0;
+};
+
+#endif // OBJECTPOOL_H
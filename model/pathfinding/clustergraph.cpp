@@ -0,0 +1,137 @@
+#include "clustergraph.h"
+
+#include <QHash>
+#include <QPromise>
+#include <QtConcurrent>
+#include <cmath>
+
+#include "model/pathfinding/pathworkspace.h"
+
+ClusterGraph::ClusterGraph(int columns, int rows)
+    : m_columns(columns)
+    , m_rows(rows)
+    , m_clusterRows((rows + SETTINGS::CLUSTER_SIZE - 1) / SETTINGS::CLUSTER_SIZE) {
+}
+
+QRect ClusterGraph::area(int cluster) const {
+    int x = (cluster / m_clusterRows) * SETTINGS::CLUSTER_SIZE;
+    int y = (cluster % m_clusterRows) * SETTINGS::CLUSTER_SIZE;
+    return QRect(x, y, qMin(SETTINGS::CLUSTER_SIZE, m_columns - x), qMin(SETTINGS::CLUSTER_SIZE, m_rows - y));
+}
+
+QSharedPointer<const ClusterGraph> ClusterGraph::build(const QSharedPointer<const CostGrid> &costs,
+                                                       const std::function<bool()> &isCanceled) {
+    int columns = costs->getColumnCount();
+    int rows = costs->getRowCount();
+    if(columns * rows < SETTINGS::MIN_CELLS) {
+        return {};
+    }
+
+    QSharedPointer<ClusterGraph> graph(new ClusterGraph(columns, rows));
+    int clusterColumns = (columns + SETTINGS::CLUSTER_SIZE - 1) / SETTINGS::CLUSTER_SIZE;
+    int clusterCount = clusterColumns * graph->m_clusterRows;
+
+    std::vector<std::vector<int>> clusterNodes(clusterCount);
+    std::vector<std::vector<Edge>> edges;
+    QHash<int, int> nodeOfCell;
+    auto nodeOf = [&](QPoint position) {
+        int cell = costs->index(position.x(), position.y());
+        auto it = nodeOfCell.constFind(cell);
+        if(it != nodeOfCell.cend()) {
+            return *it;
+        }
+        int node = graph->m_nodeCells.size();
+        graph->m_nodeCells.push_back(cell);
+        edges.emplace_back();
+        clusterNodes[graph->clusterOf(position)].push_back(node);
+        nodeOfCell.insert(cell, node);
+        return node;
+    };
+    auto isWalkable = [&](QPoint position) {
+        return std::isfinite(costs->cost(costs->index(position.x(), position.y())));
+    };
+    // Joins the two facing tiles a and b, stepping across costs the tile that is entered.
+    auto addEntrance = [&](QPoint a, QPoint b) {
+        int nodeA = nodeOf(a);
+        int nodeB = nodeOf(b);
+        edges[nodeA].push_back({nodeB, costs->cost(costs->index(b.x(), b.y()))});
+        edges[nodeB].push_back({nodeA, costs->cost(costs->index(a.x(), a.y()))});
+    };
+    // Finds the entrances along a border, first is the first tile on the near side and step goes along the border.
+    auto scanBorder = [&](QPoint first, QPoint across, QPoint step, int length) {
+        int runStart = -1;
+        for(int i = 0; i <= length; ++i) {
+            QPoint near = first + step * i;
+            bool open = i < length && isWalkable(near) && isWalkable(near + across);
+            if(open && runStart < 0) {
+                runStart = i;
+            } else if(!open && runStart >= 0) {
+                int runEnd = i - 1;
+                if(runEnd - runStart + 1 >= SETTINGS::LONG_ENTRANCE) {
+                    addEntrance(first + step * runStart, first + step * runStart + across);
+                    addEntrance(first + step * runEnd, first + step * runEnd + across);
+                } else {
+                    int middle = (runStart + runEnd) / 2;
+                    addEntrance(first + step * middle, first + step * middle + across);
+                }
+                runStart = -1;
+            }
+        }
+    };
+
+    for(int cluster = 0; cluster < clusterCount; ++cluster) {
+        QRect area = graph->area(cluster);
+        // Every border is scanned once, from the cluster on its left or on its top.
+        if(area.right() + 1 < columns) {
+            scanBorder(area.topRight(), QPoint(1, 0), QPoint(0, 1), area.height());
+        }
+        if(area.bottom() + 1 < rows) {
+            scanBorder(area.bottomLeft(), QPoint(0, 1), QPoint(1, 0), area.width());
+        }
+    }
+
+    // The cheapest way between the nodes of a cluster without leaving it.
+    PathWorkspace workspace(costs);
+    for(int cluster = 0; cluster < clusterCount; ++cluster) {
+        if(isCanceled && isCanceled()) {
+            return {};
+        }
+        QRect area = graph->area(cluster);
+        for(int node : clusterNodes[cluster]) {
+            workspace.explore(graph->m_nodeCells[node], area);
+            for(int other : clusterNodes[cluster]) {
+                float cost = workspace.distance(graph->m_nodeCells[other]);
+                if(other != node && std::isfinite(cost)) {
+                    edges[node].push_back({other, cost});
+                }
+            }
+        }
+    }
+
+    // Flattened, so a search walks contiguous memory.
+    graph->m_edgeStart.reserve(edges.size() + 1);
+    graph->m_edgeStart.push_back(0);
+    for(const auto &nodeEdges : edges) {
+        graph->m_edges.insert(graph->m_edges.end(), nodeEdges.begin(), nodeEdges.end());
+        graph->m_edgeStart.push_back(graph->m_edges.size());
+    }
+    graph->m_clusterStart.reserve(clusterCount + 1);
+    graph->m_clusterStart.push_back(0);
+    for(const auto &nodes : clusterNodes) {
+        graph->m_clusterNodes.insert(graph->m_clusterNodes.end(), nodes.begin(), nodes.end());
+        graph->m_clusterStart.push_back(graph->m_clusterNodes.size());
+    }
+    return graph;
+}
+
+QFuture<QSharedPointer<const ClusterGraph>> ClusterGraph::buildLater(const QSharedPointer<const CostGrid> &costs) {
+    return QtConcurrent::run([costs](QPromise<QSharedPointer<const ClusterGraph>> &promise) {
+        if(promise.isCanceled()) {
+            return;
+        }
+        auto graph = build(costs, [&promise] { return promise.isCanceled(); });
+        if(!promise.isCanceled()) {
+            promise.addResult(graph);
+        }
+    });
+}
@@ -0,0 +1,139 @@
+#ifndef CLUSTERGRAPH_H
+#define CLUSTERGRAPH_H
+
+#include <QFuture>
+#include <QRect>
+#include <QSharedPointer>
+#include <cstdlib>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "model/pathfinding/costgrid.h"
+
+/**
+ * @brief The ClusterGraph class is the abstract graph of hierarchical pathfinding (HPA*) on a big level.
+ * The level is split into square clusters of CLUSTER_SIZE tiles. Where a run of walkable tiles crosses the border of
+ * two clusters there is an entrance, one pair of tiles facing each other in the middle of short runs and one at each
+ * end of long ones. Those tiles are the nodes of the graph. Two facing nodes are joined by the cost of stepping
+ * across, the nodes of a cluster by the cost of the cheapest path between them that stays inside the cluster.
+ * The graph is built once with the level and only read after that, PathWorkspace does the searches on it.
+ */
+class ClusterGraph {
+public:
+    /// Cluster settings
+    static const struct SETTINGS {
+        /// The width and height of a cluster in tiles.
+        static constexpr int CLUSTER_SIZE = 16;
+        /// Levels with fewer tiles are searched without a graph, a flat search is fast enough.
+        static constexpr int MIN_CELLS = 256 * 256;
+        /// Runs of at least this many tiles get an entrance at both ends instead of one in the middle.
+        static constexpr int LONG_ENTRANCE = 6;
+    } Settings;
+
+    /**
+     * @brief The Edge struct is a way from a node to another one.
+     */
+    struct Edge {
+        /// The node it goes to
+        int node;
+        /// The cost of going there, without the cost of the node it starts from
+        float cost;
+    };
+
+    /**
+     * @brief build Makes the graph of a level, takes about a second for a level of 1500x1500 tiles.
+     * @param costs The costs of the level.
+     * @param isCanceled Returns true once the graph is not wanted anymore, checked after every cluster. Empty for never.
+     * @return The graph, null for levels under MIN_CELLS and when it was cancelled.
+     */
+    static QSharedPointer<const ClusterGraph> build(const QSharedPointer<const CostGrid> &costs,
+                                                    const std::function<bool()> &isCanceled = {});
+
+    /**
+     * @brief buildLater Runs build() in the global thread pool.
+     * @param costs The costs of the level.
+     * @return The graph once it is built, see PathWorkspace::setClusters().
+     */
+    static QFuture<QSharedPointer<const ClusterGraph>> buildLater(const QSharedPointer<const CostGrid> &costs);
+
+    /**
+     * @brief nodeCount The number of nodes.
+     */
+    int nodeCount() const {
+        return m_nodeCells.size();
+    }
+
+    /**
+     * @brief cell The tile of a node.
+     */
+    int cell(int node) const {
+        return m_nodeCells[node];
+    }
+
+    /**
+     * @brief edges The ways out of a node.
+     */
+    std::span<const Edge> edges(int node) const {
+        return std::span<const Edge>(m_edges).subspan(m_edgeStart[node], m_edgeStart[node + 1] - m_edgeStart[node]);
+    }
+
+    /**
+     * @brief clusterOf The cluster of a tile.
+     */
+    int clusterOf(QPoint position) const {
+        return (position.x() / SETTINGS::CLUSTER_SIZE) * m_clusterRows + position.y() / SETTINGS::CLUSTER_SIZE;
+    }
+
+    /**
+     * @brief area The tiles of a cluster, the clusters on the right and bottom border can be smaller.
+     */
+    QRect area(int cluster) const;
+
+    /**
+     * @brief nodes The nodes on the border of a cluster.
+     */
+    std::span<const int> nodes(int cluster) const {
+        return std::span<const int>(m_clusterNodes).subspan(m_clusterStart[cluster], m_clusterStart[cluster + 1] - m_clusterStart[cluster]);
+    }
+
+    /**
+     * @brief isNear Checks if two tiles are in the same or in neighboring clusters, the graph does not help then.
+     */
+    bool isNear(QPoint a, QPoint b) const {
+        return std::abs(a.x() / SETTINGS::CLUSTER_SIZE - b.x() / SETTINGS::CLUSTER_SIZE) <= 1
+               && std::abs(a.y() / SETTINGS::CLUSTER_SIZE - b.y() / SETTINGS::CLUSTER_SIZE) <= 1;
+    }
+
+private:
+    /**
+     * @brief ClusterGraph constructor, only used by build().
+     */
+    ClusterGraph(int columns, int rows);
+
+    /**
+     * @brief m_columns, m_rows The size of the level in tiles.
+     */
+    int m_columns;
+    int m_rows;
+    /**
+     * @brief m_clusterRows The number of clusters in a column.
+     */
+    int m_clusterRows;
+    /**
+     * @brief m_nodeCells The tile of every node.
+     */
+    std::vector<int> m_nodeCells;
+    /**
+     * @brief m_edgeStart, m_edges The edges of every node, those of node n are [m_edgeStart[n], m_edgeStart[n + 1]).
+     */
+    std::vector<int> m_edgeStart;
+    std::vector<Edge> m_edges;
+    /**
+     * @brief m_clusterStart, m_clusterNodes The nodes of every cluster, stored like the edges.
+     */
+    std::vector<int> m_clusterStart;
+    std::vector<int> m_clusterNodes;
+};
+
+#endif // CLUSTERGRAPH_H
@@ -0,0 +1,52 @@
+#include "costgrid.h"
+
+#include <cmath>
+
+CostGrid::CostGrid(int columns, int rows)
+    : m_columns(columns)
+    , m_rows(rows)
+    , m_costs(columns * rows, INFINITY)
+    , m_minCost(INFINITY) {
+}
+
+void CostGrid::setTerrain(int x, int y, float energy) {
+    setCost(index(x, y), energy);
+}
+
+void CostGrid::addObject(int x, int y, ObjectType type) {
+    switch(type) {
+    case ObjectType::HealthPack:
+        setCost(index(x, y), SETTINGS::HEALTH_PACK_COST);
+        break;
+    case ObjectType::Enemy:
+    case ObjectType::PoisonEnemy:
+        setCost(index(x, y), SETTINGS::ENEMY_COST);
+        break;
+    default:
+        break;
+    }
+}
+
+int CostGrid::move(QPoint step) {
+    static constexpr int MOVE_OF[3][3] = {
+      {1, 0, 7}, // dy = -1: TopLeft, Up, TopRight
+      {2, -1, 6}, // dy = 0: Left, -, Right
+      {3, 4, 5}, // dy = 1: BottomLeft, Down, BottomRight
+    };
+    return MOVE_OF[step.y() + 1][step.x() + 1];
+}
+
+std::vector<int> CostGrid::moves(const std::vector<int> &cells) const {
+    std::vector<int> moves;
+    for(size_t i = 1; i < cells.size(); ++i) {
+        moves.push_back(move(position(cells[i]) - position(cells[i - 1])));
+    }
+    return moves;
+}
+
+void CostGrid::setCost(int index, float cost) {
+    m_costs[index] = cost;
+    if(cost < m_minCost) {
+        m_minCost = cost;
+    }
+}
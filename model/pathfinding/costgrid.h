@@ -0,0 +1,144 @@
+#ifndef COSTGRID_H
+#define COSTGRID_H
+
+#include <QPoint>
+#include <vector>
+
+#include "publicenums.h"
+
+/**
+ * @brief The CostGrid class is what the pathfinders search: the energy it costs to step onto every tile of a level.
+ * Tiles with a health pack are almost free and tiles with an enemy cost a bit, so paths go through health packs and
+ * fight the enemies on the way instead of walking around them. Walls have an infinite cost.
+ * The cells have the same index as in the WorldGrid (x * rows + y). The grid is built with the level and only read
+ * by the searches after that, so one grid can be shared by every search on a level.
+ */
+class CostGrid {
+public:
+    /// Cost settings
+    static const struct SETTINGS {
+        /// The cost of a tile with a health pack
+        static constexpr float HEALTH_PACK_COST = 0.01f;
+        /// The cost of a tile with an enemy
+        static constexpr float ENEMY_COST = 0.8f;
+    } Settings;
+
+    /**
+     * @brief MOVES The offset of every move of a path, the direction of move m is 45 * m + 90 degrees.
+     */
+    static constexpr QPoint MOVES[8] = {{0, -1}, {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 1}, {1, 0}, {1, -1}};
+
+    /**
+     * @brief CostGrid constructor, every tile starts as a wall.
+     * @param columns The number of columns of the level.
+     * @param rows The number of rows of the level.
+     */
+    CostGrid(int columns = 0, int rows = 0);
+
+    /**
+     * @brief getColumnCount The number of columns (x) in the grid.
+     */
+    int getColumnCount() const {
+        return m_columns;
+    }
+
+    /**
+     * @brief getRowCount The number of rows (y) in the grid.
+     */
+    int getRowCount() const {
+        return m_rows;
+    }
+
+    /**
+     * @brief size The number of cells.
+     */
+    int size() const {
+        return m_costs.size();
+    }
+
+    /**
+     * @brief index The index of a cell, the same as WorldGrid::index.
+     */
+    int index(int x, int y) const {
+        return x * m_rows + y;
+    }
+
+    /**
+     * @brief position The location of a cell.
+     */
+    QPoint position(int index) const {
+        return QPoint(index / m_rows, index % m_rows);
+    }
+
+    /**
+     * @brief contains Checks if a location is inside the level.
+     */
+    bool contains(int x, int y) const {
+        return x >= 0 && y >= 0 && x < m_columns && y < m_rows;
+    }
+
+    /**
+     * @brief cost The cost of stepping onto a cell, infinity for walls.
+     */
+    float cost(int index) const {
+        return m_costs[index];
+    }
+
+    /**
+     * @brief minCost The lowest cost of a cell that is not a wall, the cost of a step in the heuristics.
+     */
+    float minCost() const {
+        return m_minCost;
+    }
+
+    /**
+     * @brief setTerrain Sets the cost of a tile to its energy.
+     * @param x The column of the tile.
+     * @param y The row of the tile.
+     * @param energy The energy of the tile, infinite for walls.
+     */
+    void setTerrain(int x, int y, float energy);
+
+    /**
+     * @brief addObject Changes the cost of a tile for an object placed on it, only health packs and enemies matter.
+     * @param x The column of the tile.
+     * @param y The row of the tile.
+     * @param type The type of the object.
+     */
+    void addObject(int x, int y, ObjectType type);
+
+    /**
+     * @brief move The move that goes from a cell to a neighbor, encoded like MOVES.
+     * @param step The offset of the neighbor, both coordinates in [-1, 1] and not both 0.
+     */
+    static int move(QPoint step);
+
+    /**
+     * @brief moves Turns a list of cells into the moves that go from each one to the next.
+     * @param cells The cells of a path, the first one is where the path starts.
+     * @return The moves, one less than cells.
+     */
+    std::vector<int> moves(const std::vector<int> &cells) const;
+
+private:
+    /**
+     * @brief setCost Sets the cost of a cell and keeps the lowest cost up to date.
+     */
+    void setCost(int index, float cost);
+
+    /**
+     * @brief m_columns, m_rows The size of the level.
+     */
+    int m_columns;
+    int m_rows;
+    /**
+     * @brief m_costs The cost of every cell.
+     */
+    std::vector<float> m_costs;
+    /**
+     * @brief m_minCost The lowest cost of a cell that is not a wall, a lower bound if a cell got more expensive.
+     */
+    float m_minCost;
+};
+
+#endif // COSTGRID_H
@@ -0,0 +1,307 @@
+#include "dstarlite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+
+#include "model/distancefield.h"
+#include "model/pathfinding/costgrid.h"
+
+namespace {
+    /// The occupants that change the cost of a tile, see DStarLite::cost.
+    constexpr quint8 HEALTH_PACK_MASK = WorldGrid::typeBit(ObjectType::HealthPack);
+    constexpr quint8 ENEMY_MASK = WorldGrid::typeMask({ObjectType::_ENEMIES_START, ObjectType::_ENEMIES_END});
+
+    /**
+     * @brief forEachNeighbor Calls f with the index of each of the 8 neighbors of a cell that are inside the grid.
+     */
+    template <typename F>
+    void forEachNeighbor(const WorldGrid &grid, int index, F f) {
+        QPoint position = grid.position(index);
+        for(const QPoint &step : CostGrid::MOVES) {
+            QPoint next = position + step;
+            if(grid.contains(next.x(), next.y())) {
+                f(grid.index(next.x(), next.y()));
+            }
+        }
+    }
+}
+
+DStarLite::DStarLite(WorldGrid *grid)
+    : m_grid(grid) {
+    m_grid->addObserver(this);
+}
+
+DStarLite::~DStarLite() {
+    m_grid->removeObserver(this);
+}
+
+void DStarLite::setGoal(QPoint goal) {
+    int cell = m_grid->contains(goal.x(), goal.y()) ? m_grid->index(goal.x(), goal.y()) : -1;
+    if(cell == m_goal) {
+        return;
+    }
+    m_goal = cell;
+    // The tree is built again on the next query.
+    m_start = -1;
+    m_dirty.clear();
+}
+
+int DStarLite::nextMove(QPoint start) {
+    int cell = m_grid->index(start.x(), start.y());
+    update(cell);
+    int next = -1;
+    if(cell == m_goal || !std::isfinite(bestNeighbor(cell, &next))) {
+        return -1;
+    }
+    return CostGrid::move(m_grid->position(next) - start);
+}
+
+std::vector<int> DStarLite::path(QPoint start) {
+    int cell = m_grid->index(start.x(), start.y());
+    update(cell);
+    std::vector<int> moves;
+    while(cell != m_goal && (int)moves.size() < m_grid->size()) {
+        int next = -1;
+        if(!std::isfinite(bestNeighbor(cell, &next))) {
+            return {};
+        }
+        moves.push_back(CostGrid::move(m_grid->position(next) - m_grid->position(cell)));
+        cell = next;
+    }
+    return moves;
+}
+
+void DStarLite::occupantsChanged(int index, quint8 oldMask, quint8 newMask) {
+    // The protagonist walking around does not change any cost.
+    if(((oldMask ^ newMask) & (HEALTH_PACK_MASK | ENEMY_MASK))) {
+        costChanged(index);
+    }
+}
+
+void DStarLite::costChanged(int index) {
+    if(m_start < 0) {
+        return;
+    }
+    // A level that changes a lot while nobody walks it is cheaper to search again.
+    if(m_dirty.size() >= m_grid->size()) {
+        m_start = -1;
+        m_dirty.clear();
+        return;
+    }
+    m_dirty.append(index);
+}
+
+float DStarLite::cost(int index) const {
+    float energy = m_grid->get<DataRole::Energy>(index);
+    if(!std::isfinite(energy)) {
+        return INFINITY;
+    }
+    quint8 occupants = m_grid->occupants(index);
+    if(occupants & HEALTH_PACK_MASK) {
+        energy = CostGrid::SETTINGS::HEALTH_PACK_COST;
+    } else if(occupants & ENEMY_MASK) {
+        energy = CostGrid::SETTINGS::ENEMY_COST;
+    }
+    return energy + m_grid->get<DataRole::PoisonLevel>(index) * DistanceField::SETTINGS::POISON_COST;
+}
+
+void DStarLite::reset() {
+    if(m_stamp.size() != (size_t)m_grid->size()) {
+        m_stamp.assign(m_grid->size(), 0);
+        m_g.resize(m_grid->size());
+        m_rhs.resize(m_grid->size());
+        m_cost.resize(m_grid->size());
+        m_key.resize(m_grid->size());
+        m_queued.resize(m_grid->size());
+        m_generation = 0;
+
+        // Tiles only get more expensive with poison and a health pack or an enemy can be on any tile.
+        m_minCost = qMin(CostGrid::SETTINGS::HEALTH_PACK_COST, CostGrid::SETTINGS::ENEMY_COST);
+        for(int cell = 0; cell < m_grid->size(); ++cell) {
+            m_minCost = qMin(m_minCost, m_grid->get<DataRole::Energy>(cell));
+        }
+    }
+    if(++m_generation == 0) {
+        std::fill(m_stamp.begin(), m_stamp.end(), 0);
+        m_generation = 1;
+    }
+
+    m_km = 0;
+    m_open.clear();
+    m_dirty.clear();
+    touch(m_goal);
+    m_rhs[m_goal] = 0;
+    updateVertex(m_goal);
+}
+
+void DStarLite::touch(int cell) {
+    if(m_stamp[cell] == m_generation) {
+        return;
+    }
+    m_stamp[cell] = m_generation;
+    m_g[cell] = INFINITY;
+    m_rhs[cell] = INFINITY;
+    m_cost[cell] = cost(cell);
+    m_queued[cell] = false;
+}
+
+DStarLite::Key DStarLite::key(int cell) const {
+    float g = qMin(m_g[cell], m_rhs[cell]);
+    return {g + heuristic(m_start, cell) + m_km, g};
+}
+
+float DStarLite::heuristic(int a, int b) const {
+    QPoint from = m_grid->position(a);
+    QPoint to = m_grid->position(b);
+    return qMax(qAbs(from.x() - to.x()), qAbs(from.y() - to.y())) * m_minCost;
+}
+
+float DStarLite::bestNeighbor(int cell, int *next) {
+    float best = INFINITY;
+    forEachNeighbor(*m_grid, cell, [&](int neighbor) {
+        touch(neighbor);
+        float through = m_cost[neighbor] + m_g[neighbor];
+        if(through < best) {
+            best = through;
+            if(next) {
+                *next = neighbor;
+            }
+        }
+    });
+    return best;
+}
+
+void DStarLite::updateVertex(int cell) {
+    if(m_g[cell] == m_rhs[cell]) {
+        m_queued[cell] = false;
+        return;
+    }
+    Key current = key(cell);
+    if(m_queued[cell] && m_key[cell] == current) {
+        return;
+    }
+    m_key[cell] = current;
+    m_queued[cell] = true;
+    m_open.push_back({current, cell});
+    std::push_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+}
+
+void DStarLite::update(int start) {
+    m_expansions = 0;
+    if(m_goal < 0) {
+        return;
+    }
+    if(m_start < 0) {
+        m_start = start;
+        reset();
+    } else {
+        if(start != m_start) {
+            m_km += heuristic(m_start, start);
+            m_start = start;
+        }
+        for(int cell : std::exchange(m_dirty, {})) {
+            if(!applyChange(cell)) {
+                reset();
+                break;
+            }
+        }
+    }
+    touch(m_start);
+    computeShortestPath();
+}
+
+bool DStarLite::applyChange(int cell) {
+    // A tile the search has not met yet is read from the grid when it is.
+    if(m_stamp[cell] != m_generation) {
+        return true;
+    }
+    float oldCost = m_cost[cell];
+    float newCost = cost(cell);
+    if(oldCost == newCost) {
+        return true;
+    }
+    if(newCost < m_minCost) {
+        m_minCost = newCost;
+        return false;
+    }
+    m_cost[cell] = newCost;
+    // Only the ways into the tile changed, they only matter if the goal can be reached from it.
+    if(!std::isfinite(m_g[cell])) {
+        return true;
+    }
+
+    forEachNeighbor(*m_grid, cell, [&](int neighbor) {
+        touch(neighbor);
+        if(neighbor == m_goal) {
+            return;
+        }
+        if(newCost < oldCost) {
+            m_rhs[neighbor] = qMin(m_rhs[neighbor], newCost + m_g[cell]);
+        } else if(m_rhs[neighbor] == oldCost + m_g[cell]) {
+            m_rhs[neighbor] = bestNeighbor(neighbor);
+        }
+        updateVertex(neighbor);
+    });
+    return true;
+}
+
+void DStarLite::computeShortestPath() {
+    while(true) {
+        // Entries that were pushed again with another key, or settled since, are skipped.
+        while(!m_open.empty() && (!m_queued[m_open.front().cell] || !(m_open.front().key == m_key[m_open.front().cell]))) {
+            std::pop_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+            m_open.pop_back();
+        }
+        if(m_open.empty()) {
+            break;
+        }
+        Entry top = m_open.front();
+        if(!(top.key < key(m_start)) && m_rhs[m_start] == m_g[m_start]) {
+            break;
+        }
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+        m_open.pop_back();
+
+        int current = top.cell;
+        Key now = key(current);
+        if(top.key < now) {
+            // The start moved since the tile was pushed.
+            m_key[current] = now;
+            m_open.push_back({now, current});
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+            continue;
+        }
+        m_expansions++;
+        m_queued[current] = false;
+
+        if(m_g[current] > m_rhs[current]) {
+            // Cheaper than it was, the neighbors can go through it.
+            m_g[current] = m_rhs[current];
+            float through = m_cost[current] + m_g[current];
+            forEachNeighbor(*m_grid, current, [&](int neighbor) {
+                touch(neighbor);
+                if(neighbor != m_goal && through < m_rhs[neighbor]) {
+                    m_rhs[neighbor] = through;
+                    updateVertex(neighbor);
+                }
+            });
+        } else {
+            // More expensive, every neighbor that went through it looks for another way.
+            float through = m_cost[current] + m_g[current];
+            m_g[current] = INFINITY;
+            auto repair = [&](int cell) {
+                if(cell != m_goal && (cell == current || m_rhs[cell] == through)) {
+                    m_rhs[cell] = bestNeighbor(cell);
+                }
+                updateVertex(cell);
+            };
+            repair(current);
+            forEachNeighbor(*m_grid, current, [&](int neighbor) {
+                touch(neighbor);
+                repair(neighbor);
+            });
+        }
+    }
+}
@@ -0,0 +1,202 @@
+#ifndef DSTARLITE_H
+#define DSTARLITE_H
+
+#include <QList>
+#include <QPoint>
+#include <vector>
+
+#include "model/worldgrid.h"
+
+/**
+ * @brief The DStarLite class walks the protagonist to a goal and replans as the level changes (D* Lite).
+ * It searches backwards from the goal, so the search tree stays valid while the protagonist moves along it.
+ * The costs are read from the WorldGrid as they are now, like the CostGrid computes them plus the poison of the tiles:
+ * moving enemies, spreading poison and health packs that are picked up all change them.
+ * The planner follows the grid as a GridObserver. Changes are queued and applied on the next query, which only
+ * repairs the tiles whose cost to the goal went through a changed tile instead of searching the level again.
+ * The arrays are allocated on the first query and reset by generation, it takes about 25 bytes per tile,
+ * so it is meant for the levels that are searched without a ClusterGraph.
+ */
+class DStarLite : public GridObserver {
+public:
+    /**
+     * @brief DStarLite constructor, registers the planner as observer of the grid.
+     * @param grid The grid of the level, has to outlive the planner.
+     */
+    explicit DStarLite(WorldGrid *grid);
+    ~DStarLite() override;
+
+    /**
+     * @brief setGoal Sets the tile to go to. The search tree is only dropped if the goal is another one.
+     * @param goal The location of the goal.
+     */
+    void setGoal(QPoint goal);
+
+    /**
+     * @brief goal The location of the goal, (-1, -1) before setGoal().
+     */
+    QPoint goal() const {
+        return m_goal < 0 ? QPoint(-1, -1) : m_grid->position(m_goal);
+    }
+
+    /**
+     * @brief nextMove Applies the changes of the level and gives the first move of the cheapest way to the goal.
+     * @param start Where the protagonist is now.
+     * @return The move, encoded like CostGrid::MOVES, -1 on the goal or if it can not be reached.
+     */
+    int nextMove(QPoint start);
+
+    /**
+     * @brief path Applies the changes of the level and gives every move to the goal.
+     * @param start Where the protagonist is now.
+     * @return The moves, encoded like CostGrid::MOVES, empty on the goal or if it can not be reached.
+     */
+    std::vector<int> path(QPoint start);
+
+    /**
+     * @brief expansions The number of tiles the last query expanded, 0 when nothing changed.
+     */
+    int expansions() const {
+        return m_expansions;
+    }
+
+    void occupantsChanged(int index, quint8 oldMask, quint8 newMask) override;
+    void costChanged(int index) override;
+
+private:
+    /**
+     * @brief The Key struct orders the open list, the lowest f first and the lowest g on ties.
+     */
+    struct Key {
+        float f;
+        float g;
+        bool operator<(const Key &other) const {
+            return f < other.f || (f == other.f && g < other.g);
+        }
+        bool operator==(const Key &other) const = default;
+    };
+
+    /**
+     * @brief The Entry struct is a tile in the open list, with the key it had when it was pushed.
+     */
+    struct Entry {
+        Key key;
+        int cell;
+        bool operator>(const Entry &other) const {
+            return other.key < key;
+        }
+    };
+
+    /**
+     * @brief cost The cost of moving onto a tile, read from the grid.
+     */
+    float cost(int index) const;
+
+    /**
+     * @brief reset Drops the search tree, the goal is the only tile in the open list afterwards.
+     * Allocates the arrays the first time.
+     */
+    void reset();
+
+    /**
+     * @brief touch Gives a tile its starting values the first time this search meets it.
+     */
+    void touch(int cell);
+
+    /**
+     * @brief key The key of a tile for the current start.
+     */
+    Key key(int cell) const;
+
+    /**
+     * @brief heuristic The lower bound of the cost between two tiles.
+     */
+    float heuristic(int a, int b) const;
+
+    /**
+     * @brief bestNeighbor The cheapest way to the goal through one of the neighbors of a tile.
+     * @param cell The tile.
+     * @param next Where the neighbor is written, if not null.
+     * @return The cost, infinity if no neighbor leads to the goal.
+     */
+    float bestNeighbor(int cell, int *next = nullptr);
+
+    /**
+     * @brief updateVertex Puts a tile in the open list if its cost is not settled, takes it out otherwise.
+     */
+    void updateVertex(int cell);
+
+    /**
+     * @brief update Moves the start, applies the queued changes and repairs the search tree.
+     * @param start The tile of the protagonist.
+     */
+    void update(int start);
+
+    /**
+     * @brief applyChange Updates the ways into a tile whose cost changed.
+     * @return False if the cost went under the bound of the heuristic, the tree has to be built again.
+     */
+    bool applyChange(int cell);
+
+    /**
+     * @brief computeShortestPath Expands the open list until the cost of the start is settled.
+     */
+    void computeShortestPath();
+
+    /**
+     * @brief m_grid The grid of the level.
+     */
+    WorldGrid *m_grid;
+    /**
+     * @brief m_goal The goal tile, -1 for none.
+     */
+    int m_goal = -1;
+    /**
+     * @brief m_start The tile the last query started from.
+     */
+    int m_start = -1;
+    /**
+     * @brief m_km How much the heuristic of the keys in the open list is behind, the start moved that far since.
+     */
+    float m_km = 0;
+    /**
+     * @brief m_minCost The lowest cost a tile can have, the heuristic is the distance times this.
+     */
+    float m_minCost = 0;
+    /**
+     * @brief m_expansions The expansions of the last query.
+     */
+    int m_expansions = 0;
+    /**
+     * @brief m_generation The current search tree, tiles with an older stamp have not been met yet.
+     */
+    quint32 m_generation = 0;
+    /**
+     * @brief m_stamp The generation in which each tile was met.
+     */
+    std::vector<quint32> m_stamp;
+    /**
+     * @brief m_g, m_rhs The cost to the goal of each tile and the one seen from its neighbors, equal once settled.
+     */
+    std::vector<float> m_g;
+    std::vector<float> m_rhs;
+    /**
+     * @brief m_cost The cost of each tile as the search tree knows it.
+     */
+    std::vector<float> m_cost;
+    /**
+     * @brief m_key, m_queued The key of each tile in the open list, and if it is in there.
+     */
+    std::vector<Key> m_key;
+    std::vector<bool> m_queued;
+    /**
+     * @brief m_open The open list, a binary heap. Entries whose key is outdated are skipped when they come up.
+     */
+    std::vector<Entry> m_open;
+    /**
+     * @brief m_dirty Tiles whose cost might have changed since the last query.
+     */
+    QList<int> m_dirty;
+};
+
+#endif // DSTARLITE_H
@@ -0,0 +1,71 @@
+#include "landmarktable.h"
+
+#include <QPromise>
+#include <QtConcurrent>
+
+#include "model/pathfinding/pathworkspace.h"
+
+QSharedPointer<const LandmarkTable> LandmarkTable::build(const QSharedPointer<const CostGrid> &costs) {
+    if(costs->size() > SETTINGS::MAX_CELLS) {
+        return {};
+    }
+
+    QSharedPointer<LandmarkTable> table(new LandmarkTable());
+    table->m_landmarks = chooseLandmarks(*costs);
+    qsizetype count = table->m_landmarks.size();
+    table->m_distances.resize((size_t)costs->size() * 2 * count);
+
+    QRect level(0, 0, costs->getColumnCount(), costs->getRowCount());
+    PathWorkspace workspace(costs);
+    for(qsizetype i = 0; i < count; ++i) {
+        int landmark = costs->index(table->m_landmarks[i].x(), table->m_landmarks[i].y());
+        for(int reverse = 0; reverse < 2; ++reverse) {
+            workspace.explore(landmark, level, reverse);
+            for(int cell = 0; cell < costs->size(); ++cell) {
+                table->m_distances[(size_t)cell * 2 * count + 2 * i + reverse] = workspace.distance(cell);
+            }
+        }
+    }
+    return table;
+}
+
+QFuture<QSharedPointer<const LandmarkTable>> LandmarkTable::buildLater(const QSharedPointer<const CostGrid> &costs) {
+    return QtConcurrent::run([costs](QPromise<QSharedPointer<const LandmarkTable>> &promise) {
+        if(promise.isCanceled()) {
+            return;
+        }
+        promise.addResult(build(costs));
+    });
+}
+
+QList<QPoint> LandmarkTable::chooseLandmarks(const CostGrid &costs) {
+    int right = costs.getColumnCount() - 1;
+    int bottom = costs.getRowCount() - 1;
+    // The doorways are on the top left and bottom right corners.
+    const QPoint wanted[] = {
+      {0, 0}, {right, bottom}, {right, 0}, {0, bottom},
+      {right / 2, 0}, {right / 2, bottom}, {0, bottom / 2}, {right, bottom / 2},
+    };
+
+    QList<QPoint> landmarks;
+    for(const QPoint &point : wanted) {
+        // Walls can not be landmarks, the closest walkable tile is taken instead.
+        bool found = false;
+        for(int radius = 0; !found && radius <= qMax(right, bottom); ++radius) {
+            for(int dx = -radius; !found && dx <= radius; ++dx) {
+                for(int dy = -radius; !found && dy <= radius; ++dy) {
+                    QPoint candidate = point + QPoint(dx, dy);
+                    if(qMax(qAbs(dx), qAbs(dy)) != radius || !costs.contains(candidate.x(), candidate.y())
+                       || !std::isfinite(costs.cost(costs.index(candidate.x(), candidate.y())))) {
+                        continue;
+                    }
+                    found = true;
+                    if(!landmarks.contains(candidate)) {
+                        landmarks.append(candidate);
+                    }
+                }
+            }
+        }
+    }
+    return landmarks;
+}
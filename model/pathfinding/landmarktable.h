@@ -0,0 +1,93 @@
+#ifndef LANDMARKTABLE_H
+#define LANDMARKTABLE_H
+
+#include <QFuture>
+#include <QList>
+#include <QPoint>
+#include <QSharedPointer>
+#include <cmath>
+#include <vector>
+
+#include "model/pathfinding/costgrid.h"
+
+/**
+ * @brief The LandmarkTable class holds the ALT (A*, landmarks, triangle inequality) distances of a level.
+ * A few landmarks are picked on the border of the level: its corners, where the doorways are, and the middle of
+ * every side. For each of them the cost from the landmark to every tile and from every tile to the landmark
+ * is computed with Dijkstra. Moving onto a tile costs that tile, so the two are not the same.
+ * The triangle inequality then gives a lower bound of the cost between any two tiles, much closer than
+ * the distance times the lowest cost on energy weighted terrain.
+ * The table is built once per level on a worker thread and only read after that.
+ */
+class LandmarkTable {
+public:
+    /// Landmark settings
+    static const struct SETTINGS {
+        /// Bigger levels get no table, it takes 64 bytes per tile and they are searched on the ClusterGraph.
+        static constexpr int MAX_CELLS = 512 * 512;
+    } Settings;
+
+    /**
+     * @brief build Picks the landmarks of a level and computes their distances, two Dijkstra searches per landmark.
+     * @param costs The costs of the level.
+     * @return The table, null for levels over MAX_CELLS.
+     */
+    static QSharedPointer<const LandmarkTable> build(const QSharedPointer<const CostGrid> &costs);
+
+    /**
+     * @brief buildLater Runs build() in the global thread pool.
+     * @param costs The costs of the level.
+     * @return The table once it is built, see PathWorkspace::setLandmarks().
+     */
+    static QFuture<QSharedPointer<const LandmarkTable>> buildLater(const QSharedPointer<const CostGrid> &costs);
+
+    /**
+     * @brief landmarks The tiles the distances are measured from.
+     */
+    const QList<QPoint> &landmarks() const {
+        return m_landmarks;
+    }
+
+    /**
+     * @brief lowerBound The lowest cost the way from one tile to another can have.
+     * A landmark L gives d(L, to) - d(L, from) and d(from, L) - d(to, L), the best of them is returned.
+     * @param from The tile to start from.
+     * @param to The tile to go to.
+     * @return The bound, 0 if no landmark reaches both tiles.
+     */
+    float lowerBound(int from, int to) const {
+        const float *a = &m_distances[(size_t)from * 2 * m_landmarks.size()];
+        const float *b = &m_distances[(size_t)to * 2 * m_landmarks.size()];
+        float bound = 0;
+        for(qsizetype i = 0; i < 2 * m_landmarks.size(); i += 2) {
+            // Tiles a landmark does not reach give infinite or NaN differences, those tell nothing.
+            float forward = b[i] - a[i];
+            float backward = a[i + 1] - b[i + 1];
+            if(std::isfinite(forward) && forward > bound) {
+                bound = forward;
+            }
+            if(std::isfinite(backward) && backward > bound) {
+                bound = backward;
+            }
+        }
+        return bound;
+    }
+
+private:
+    /**
+     * @brief chooseLandmarks The walkable tiles closest to the corners and to the middle of the sides.
+     */
+    static QList<QPoint> chooseLandmarks(const CostGrid &costs);
+
+    /**
+     * @brief m_landmarks The landmarks.
+     */
+    QList<QPoint> m_landmarks;
+    /**
+     * @brief m_distances Per tile and per landmark, the cost from the landmark and the cost to the landmark.
+     * The values of a tile are next to each other, so a bound reads two short runs of memory.
+     */
+    std::vector<float> m_distances;
+};
+
+#endif // LANDMARKTABLE_H
@@ -0,0 +1,47 @@
+#include "pathservice.h"
+
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+PathService::~PathService() {
+    cancel();
+    // The latest search waits for the ones before it, so it is the last one to use the service.
+    if(m_future.isValid()) {
+        m_future.waitForFinished();
+    }
+}
+
+void PathService::request(const QSharedPointer<PathWorkspace> &workspace, QPoint from, QPoint to) {
+    int request = m_request.fetchAndAddRelaxed(1) + 1;
+    m_future = QtConcurrent::run([this, workspace, from, to, request]() {
+        QMutexLocker locker(&m_searching);
+        auto isCanceled = [this, request] {
+            return m_request.loadRelaxed() != request;
+        };
+        if(isCanceled()) {
+            return;
+        }
+
+        workspace->setCanceled(isCanceled);
+        auto moves = workspace->findPath(from, to);
+        workspace->setCanceled({});
+        if(workspace->wasCanceled()) {
+            return;
+        }
+        int expansions = workspace->expansions();
+        locker.unlock();
+
+        QMetaObject::invokeMethod(
+          this,
+          [this, from, to, moves = std::move(moves), expansions, isCanceled]() {
+              m_stats.searches++;
+              m_stats.expansions += expansions;
+              m_stats.lastMoves = moves.size();
+              // Another request might have come in while this one was queued.
+              if(!isCanceled()) {
+                  emit pathFound(from, to, moves);
+              }
+          },
+          Qt::QueuedConnection);
+    });
+}
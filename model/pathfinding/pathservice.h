@@ -0,0 +1,99 @@
+#ifndef PATHSERVICE_H
+#define PATHSERVICE_H
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QMutex>
+#include <QObject>
+#include <QPoint>
+#include <QSharedPointer>
+#include <vector>
+
+#include "model/pathfinding/pathworkspace.h"
+
+/**
+ * @brief The PathService class runs the searches of the pathfinder on a worker of the global QThreadPool,
+ * so a long search on a big level does not block the GUI thread. The workspace searches the CostGrid of the level,
+ * which is never written after the level is built, so the worker reads it without a lock.
+ * Only the latest request counts: a new request or cancel() stops the search that is running at its next check
+ * (see PathWorkspace::setCanceled) and the result of a search that was overtaken is dropped.
+ * The result is delivered on the thread of the service through a queued call.
+ */
+class PathService : public QObject {
+    Q_OBJECT
+public:
+    /**
+     * @brief The Stats struct counts the searches that were done and how much they expanded.
+     */
+    struct Stats {
+        /// The searches that ran to the end, delivered or overtaken
+        int searches = 0;
+        /// The cells and graph nodes all of them expanded, see PathWorkspace::expansions()
+        qint64 expansions = 0;
+        /// The moves of the last path that was found
+        int lastMoves = 0;
+    };
+
+    /**
+     * @brief PathService constructor.
+     * @param parent The parent QObject.
+     */
+    explicit PathService(QObject *parent = nullptr)
+        : QObject(parent) {};
+
+    /**
+     * @brief ~PathService Cancels the search and waits for the worker, it uses the service.
+     */
+    ~PathService() override;
+
+    /**
+     * @brief request Starts a search, the search that is running is cancelled.
+     * @param workspace The workspace of the level, only one search at a time runs on it.
+     * @param from The location to start from.
+     * @param to The location to go to.
+     */
+    void request(const QSharedPointer<PathWorkspace> &workspace, QPoint from, QPoint to);
+
+    /**
+     * @brief cancel Stops the search that is running, if any, its result is never delivered.
+     */
+    void cancel() {
+        m_request.fetchAndAddRelaxed(1);
+    }
+
+    /**
+     * @brief stats The searches so far, updated on the thread of the service.
+     */
+    const Stats &stats() const {
+        return m_stats;
+    }
+
+signals:
+    /**
+     * @brief pathFound Emitted when the latest request is done.
+     * @param from The location the search started from.
+     * @param to The location it went to.
+     * @param moves The moves, encoded like CostGrid::MOVES, empty if there is no way.
+     */
+    void pathFound(QPoint from, QPoint to, std::vector<int> moves);
+
+private:
+    /**
+     * @brief m_request The number of the latest request, a search stops when it is not the latest anymore.
+     */
+    QAtomicInt m_request;
+    /**
+     * @brief m_searching Held while a search runs, a cancelled search can still be finishing when the next one starts.
+     */
+    QMutex m_searching;
+    /**
+     * @brief m_future The latest search.
+     */
+    QFuture<void> m_future;
+    /**
+     * @brief m_stats The search counters.
+     */
+    Stats m_stats;
+};
+
+#endif // PATHSERVICE_H
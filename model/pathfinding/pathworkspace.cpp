@@ -0,0 +1,262 @@
+#include "pathworkspace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+PathWorkspace::PathWorkspace(QSharedPointer<const CostGrid> costs, QSharedPointer<const ClusterGraph> clusters)
+    : m_costs(std::move(costs))
+    , m_clusters(std::move(clusters)) {
+}
+
+std::vector<int> PathWorkspace::findPath(int from, int to) {
+    if(!m_costs || !std::isfinite(m_costs->cost(to))) {
+        return {};
+    }
+    takeBuilt();
+    m_expansions = 0;
+    m_canceled = false;
+
+    if(m_clusters && !m_clusters->isNear(m_costs->position(from), m_costs->position(to))) {
+        auto path = findAbstractPath(from, to);
+        if(!path.empty() || m_canceled) {
+            return path;
+        }
+        // Only diagonal steps across the border of a cluster lead there, the graph does not have those.
+    }
+    return findAreaPath(from, to, QRect(0, 0, m_costs->getColumnCount(), m_costs->getRowCount()));
+}
+
+std::vector<int> PathWorkspace::findPath(int from, int to, const QRect &area) {
+    takeBuilt();
+    m_expansions = 0;
+    m_canceled = false;
+    return findAreaPath(from, to, area);
+}
+
+std::vector<int> PathWorkspace::findAreaPath(int from, int to, const QRect &area) {
+    std::vector<int> path {from};
+    search(from, to, area, false);
+    if(!appendPath(to, path)) {
+        return {};
+    }
+    return path;
+}
+
+void PathWorkspace::explore(int source, const QRect &area, bool reverse) {
+    search(source, -1, area, reverse);
+}
+
+void PathWorkspace::search(int source, int target, const QRect &area, bool reverse) {
+    reset();
+    if(m_canceled) {
+        return;
+    }
+    const CostGrid &costs = *m_costs;
+    QPoint goalPosition = target >= 0 ? costs.position(target) : QPoint();
+    bool informed = target >= 0 && !reverse;
+
+    m_reached[source] = m_generation;
+    m_g[source] = 0;
+    m_parent[source] = -1;
+    m_open.push_back({informed ? heuristic(source, target, goalPosition) : 0, source});
+
+    while(!m_open.empty()) {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+        int current = m_open.back().cell;
+        m_open.pop_back();
+        // A cell can be in the open list more than once, only its cheapest entry counts.
+        if(m_closed[current] == m_generation) {
+            continue;
+        }
+        m_closed[current] = m_generation;
+        if(++m_expansions % SETTINGS::CANCEL_INTERVAL == 0 && m_isCanceled && m_isCanceled()) {
+            m_canceled = true;
+            break;
+        }
+        if(current == target) {
+            break;
+        }
+
+        QPoint position = costs.position(current);
+        for(const QPoint &step : CostGrid::MOVES) {
+            QPoint next = position + step;
+            if(!area.contains(next)) {
+                continue;
+            }
+            int neighbor = costs.index(next.x(), next.y());
+            // Going backwards, the move from the neighbor enters the current cell.
+            float g = m_g[current] + costs.cost(reverse ? current : neighbor);
+            if(!std::isfinite(g) || !std::isfinite(costs.cost(neighbor)) || m_closed[neighbor] == m_generation
+               || (m_reached[neighbor] == m_generation && g >= m_g[neighbor])) {
+                continue;
+            }
+            m_reached[neighbor] = m_generation;
+            m_g[neighbor] = g;
+            m_parent[neighbor] = current;
+            m_open.push_back({informed ? g + heuristic(neighbor, target, goalPosition) : g, neighbor});
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+        }
+    }
+}
+
+std::vector<int> PathWorkspace::findAbstractPath(int from, int to) {
+    const ClusterGraph &graph = *m_clusters;
+    const CostGrid &costs = *m_costs;
+    QPoint goal = costs.position(to);
+    int startCluster = graph.clusterOf(costs.position(from));
+    int goalCluster = graph.clusterOf(goal);
+    int goalNode = graph.nodeCount();
+
+    if(m_nodeReached.size() != (size_t)goalNode + 1) {
+        m_nodeReached.assign(goalNode + 1, 0);
+        m_nodeClosed.assign(goalNode + 1, 0);
+        m_nodeG.resize(goalNode + 1);
+        m_nodeParent.resize(goalNode + 1);
+        m_nodeGeneration = 0;
+    }
+    if(++m_nodeGeneration == 0) {
+        std::fill(m_nodeReached.begin(), m_nodeReached.end(), 0);
+        std::fill(m_nodeClosed.begin(), m_nodeClosed.end(), 0);
+        m_nodeGeneration = 1;
+    }
+
+    // The start and the goal are joined to the nodes of their clusters, like the nodes of a cluster are.
+    std::vector<std::pair<int, float>> exits;
+    explore(to, graph.area(goalCluster), true);
+    for(int node : graph.nodes(goalCluster)) {
+        float cost = distance(graph.cell(node));
+        if(std::isfinite(cost)) {
+            exits.push_back({node, cost});
+        }
+    }
+    explore(from, graph.area(startCluster));
+    if(exits.empty()) {
+        return {};
+    }
+
+    auto reach = [this, &graph, to, goal, goalNode](int node, float g, int parent) {
+        if(m_nodeClosed[node] == m_nodeGeneration || (m_nodeReached[node] == m_nodeGeneration && g >= m_nodeG[node])) {
+            return;
+        }
+        m_nodeReached[node] = m_nodeGeneration;
+        m_nodeG[node] = g;
+        m_nodeParent[node] = parent;
+        float h = node == goalNode ? 0 : heuristic(graph.cell(node), to, goal);
+        m_open.push_back({g + h, node});
+        std::push_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+    };
+
+    m_open.clear();
+    for(int node : graph.nodes(startCluster)) {
+        float cost = distance(graph.cell(node));
+        if(std::isfinite(cost)) {
+            reach(node, cost, -1);
+        }
+    }
+    while(!m_open.empty()) {
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+        int current = m_open.back().cell;
+        m_open.pop_back();
+        if(m_nodeClosed[current] == m_nodeGeneration) {
+            continue;
+        }
+        m_nodeClosed[current] = m_nodeGeneration;
+        m_expansions++;
+        if(current == goalNode) {
+            break;
+        }
+
+        for(const auto &edge : graph.edges(current)) {
+            reach(edge.node, m_nodeG[current] + edge.cost, current);
+        }
+        for(const auto &[node, cost] : exits) {
+            if(node == current) {
+                reach(goalNode, m_nodeG[current] + cost, current);
+            }
+        }
+    }
+    if(m_nodeClosed[goalNode] != m_nodeGeneration) {
+        return {};
+    }
+
+    std::vector<int> nodes;
+    for(int node = m_nodeParent[goalNode]; node != -1; node = m_nodeParent[node]) {
+        nodes.push_back(graph.cell(node));
+    }
+    std::reverse(nodes.begin(), nodes.end());
+    nodes.push_back(to);
+
+    // Every piece of the abstract path is refined inside the cluster it ends in, steps across a border are direct.
+    std::vector<int> path {from};
+    for(int cell : nodes) {
+        int current = path.back();
+        if(cell == current) {
+            continue;
+        }
+        QPoint a = costs.position(current);
+        QPoint b = costs.position(cell);
+        int cluster = graph.clusterOf(b);
+        if(graph.clusterOf(a) != cluster && std::abs(a.x() - b.x()) + std::abs(a.y() - b.y()) == 1) {
+            path.push_back(cell);
+            continue;
+        }
+        search(current, cell, graph.area(cluster), false);
+        if(!appendPath(cell, path)) {
+            return {};
+        }
+    }
+    return path;
+}
+
+bool PathWorkspace::appendPath(int target, std::vector<int> &path) const {
+    if(m_reached[target] != m_generation || m_closed[target] != m_generation) {
+        return false;
+    }
+    size_t first = path.size();
+    for(int cell = target; m_parent[cell] != -1; cell = m_parent[cell]) {
+        path.push_back(cell);
+    }
+    std::reverse(path.begin() + first, path.end());
+    return true;
+}
+
+float PathWorkspace::heuristic(int cell, int goal, QPoint goalPosition) const {
+    QPoint position = m_costs->position(cell);
+    int steps = std::max(std::abs(position.x() - goalPosition.x()), std::abs(position.y() - goalPosition.y()));
+    float bound = steps * m_costs->minCost();
+    return m_landmarks ? std::max(bound, m_landmarks->lowerBound(cell, goal)) : bound;
+}
+
+void PathWorkspace::takeBuilt() {
+    if(m_pendingClusters.isValid() && m_pendingClusters.isFinished()) {
+        if(m_pendingClusters.resultCount()) {
+            m_clusters = m_pendingClusters.result();
+        }
+        m_pendingClusters = {};
+    }
+    if(m_pendingLandmarks.isValid() && m_pendingLandmarks.isFinished()) {
+        if(m_pendingLandmarks.resultCount()) {
+            m_landmarks = m_pendingLandmarks.result();
+        }
+        m_pendingLandmarks = {};
+    }
+}
+
+void PathWorkspace::reset() {
+    m_open.clear();
+    if(m_reached.size() != (size_t)m_costs->size()) {
+        m_reached.assign(m_costs->size(), 0);
+        m_closed.assign(m_costs->size(), 0);
+        m_g.resize(m_costs->size());
+        m_parent.resize(m_costs->size());
+        m_generation = 0;
+    }
+
+    // Generation 0 is never used, so freshly allocated cells are never taken for reached ones.
+    if(++m_generation == 0) {
+        std::fill(m_reached.begin(), m_reached.end(), 0);
+        std::fill(m_closed.begin(), m_closed.end(), 0);
+        m_generation = 1;
+    }
+}
@@ -0,0 +1,281 @@
+#ifndef PATHWORKSPACE_H
+#define PATHWORKSPACE_H
+
+#include <QFuture>
+#include <QPoint>
+#include <QRect>
+#include <QSharedPointer>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "model/pathfinding/clustergraph.h"
+#include "model/pathfinding/costgrid.h"
+#include "model/pathfinding/landmarktable.h"
+
+/**
+ * @brief The PathWorkspace class runs A* searches on the CostGrid of a level. It keeps its scratch arrays
+ * (g, parent, open and closed) between searches, a search only resets them by bumping a generation counter,
+ * so it costs the cells it visits and not the size of the level. The arrays are only allocated on the first search.
+ * The heuristic is the Chebyshev distance times the lowest cost of the grid, it never overestimates so paths are
+ * the cheapest ones. Once the LandmarkTable of the level is built, the ALT bound is used when it is higher, it is
+ * admissible too and cuts the expanded cells by a lot on energy weighted terrain. On big levels with a ClusterGraph,
+ * far away goals are first searched on the graph and the path is then refined one cluster at a time, the path can
+ * then cost a bit more than the cheapest one.
+ * One workspace is made per level, it is not thread safe: it can run on a worker thread, but one search at a time.
+ */
+class PathWorkspace {
+public:
+    /// Search settings
+    static const struct SETTINGS {
+        /// The number of expansions between two checks of the cancel function.
+        static constexpr int CANCEL_INTERVAL = 1024;
+    } Settings;
+
+    /**
+     * @brief PathWorkspace constructor.
+     * @param costs The costs of the level, read only and shared with whoever else searches the level.
+     * @param clusters The abstract graph of the level, null to always search the tiles.
+     */
+    explicit PathWorkspace(QSharedPointer<const CostGrid> costs = {}, QSharedPointer<const ClusterGraph> clusters = {});
+
+    /**
+     * @brief costs The costs the searches run on.
+     */
+    const QSharedPointer<const CostGrid> &costs() const {
+        return m_costs;
+    }
+
+    /**
+     * @brief clusters The abstract graph, null on small levels and until it is built.
+     */
+    const QSharedPointer<const ClusterGraph> &clusters() const {
+        return m_clusters;
+    }
+
+    /**
+     * @brief setClusters Hands over the graph that is being built, it is used from the first search after it is done.
+     * Until then the searches run on the tiles.
+     * @param clusters The graph, from ClusterGraph::buildLater().
+     */
+    void setClusters(QFuture<QSharedPointer<const ClusterGraph>> clusters) {
+        m_pendingClusters = std::move(clusters);
+    }
+
+    /**
+     * @brief hasClusters Checks if the level is big enough to be searched on a ClusterGraph, even when the graph
+     * is still being built. Only the size of the level is read, so it is safe while a search runs on a worker.
+     */
+    bool hasClusters() const {
+        return m_costs && m_costs->size() >= ClusterGraph::SETTINGS::MIN_CELLS;
+    }
+
+    /**
+     * @brief setLandmarks Hands over the table that is being built, it is used from the first search after it is done.
+     * @param landmarks The table, from LandmarkTable::buildLater().
+     */
+    void setLandmarks(QFuture<QSharedPointer<const LandmarkTable>> landmarks) {
+        m_pendingLandmarks = std::move(landmarks);
+    }
+
+    /**
+     * @brief landmarks The landmark table, null until it is built and on big levels.
+     */
+    const QSharedPointer<const LandmarkTable> &landmarks() const {
+        return m_landmarks;
+    }
+
+    /**
+     * @brief expansions The number of cells and graph nodes the last findPath() expanded, to see how well
+     * the heuristic guides the search.
+     */
+    int expansions() const {
+        return m_expansions;
+    }
+
+    /**
+     * @brief setCanceled Sets the function that stops the searches, for searches on a worker thread.
+     * @param isCanceled Returns true once the search is not wanted anymore, called from the searching thread.
+     */
+    void setCanceled(std::function<bool()> isCanceled) {
+        m_isCanceled = std::move(isCanceled);
+    }
+
+    /**
+     * @brief wasCanceled Checks if the last findPath() was stopped, its path is empty then.
+     */
+    bool wasCanceled() const {
+        return m_canceled;
+    }
+
+    /**
+     * @brief findPath Finds a path between two cells, moving onto a cell costs its cost.
+     * @param from The cell to start from.
+     * @param to The cell to go to.
+     * @return The cells of the path, from included, empty if to can not be reached.
+     */
+    std::vector<int> findPath(int from, int to);
+
+    /**
+     * @brief findPath Finds the cheapest path that stays inside an area, the graph is not used.
+     * @param from The cell to start from, inside the area.
+     * @param to The cell to go to.
+     * @param area The tiles the path can go through.
+     * @return The cells of the path, from included, empty if to can not be reached.
+     */
+    std::vector<int> findPath(int from, int to, const QRect &area);
+
+    /**
+     * @brief findPath Overload that takes locations and returns the moves, encoded like CostGrid::MOVES.
+     * @return The moves, empty if there is no way or from is to.
+     */
+    std::vector<int> findPath(QPoint from, QPoint to) {
+        if(!m_costs || !m_costs->contains(from.x(), from.y()) || !m_costs->contains(to.x(), to.y())) {
+            return {};
+        }
+        return m_costs->moves(findPath(m_costs->index(from.x(), from.y()), m_costs->index(to.x(), to.y())));
+    }
+
+    /**
+     * @brief explore Runs Dijkstra from a cell over a whole area, read the results with distance().
+     * @param source The cell to start from.
+     * @param area The tiles to go through.
+     * @param reverse False for the cost of going from the source to every cell,
+     * true for the cost of going from every cell to the source.
+     */
+    void explore(int source, const QRect &area, bool reverse = false);
+
+    /**
+     * @brief distance The cost found by the last explore() or search, for a cell it reached.
+     * @param cell The cell.
+     * @return The cost, infinity if the cell was not reached.
+     */
+    float distance(int cell) const {
+        return m_reached[cell] == m_generation ? m_g[cell] : INFINITY;
+    }
+
+private:
+    /**
+     * @brief The Entry struct is a cell or a node in an open list.
+     */
+    struct Entry {
+        /// g + h of the cell when it was pushed
+        float f;
+        /// The cell
+        int cell;
+        bool operator>(const Entry &other) const {
+            return f > other.f;
+        }
+    };
+
+    /**
+     * @brief search Runs A* or Dijkstra from a cell inside an area.
+     * @param source The cell to start from.
+     * @param target The cell to stop at, -1 to go through the whole area.
+     * @param area The tiles to go through.
+     * @param reverse True to follow the moves backwards, see explore().
+     */
+    void search(int source, int target, const QRect &area, bool reverse);
+
+    /**
+     * @brief findAbstractPath Finds a path on the ClusterGraph and refines it.
+     * @return The cells of the path, empty if the graph found none.
+     */
+    std::vector<int> findAbstractPath(int from, int to);
+
+    /**
+     * @brief findAreaPath findPath() inside an area, without resetting the expansion counter.
+     */
+    std::vector<int> findAreaPath(int from, int to, const QRect &area);
+
+    /**
+     * @brief takeBuilt Starts using the cluster graph and the landmark table once their workers are done.
+     */
+    void takeBuilt();
+
+    /**
+     * @brief appendPath Adds the path of the last search to a path, without its first cell.
+     * @param target The cell the search stopped at.
+     * @param path The path to add to.
+     * @return False if the search did not reach the target.
+     */
+    bool appendPath(int target, std::vector<int> &path) const;
+
+    /**
+     * @brief heuristic The lower bound of the cost from a cell to the goal.
+     * @param cell The cell.
+     * @param goal The goal cell.
+     * @param goalPosition The location of the goal cell.
+     */
+    float heuristic(int cell, int goal, QPoint goalPosition) const;
+
+    /**
+     * @brief reset Starts a new generation, allocates the arrays on the first search.
+     */
+    void reset();
+
+    /**
+     * @brief m_costs The costs of the level.
+     */
+    QSharedPointer<const CostGrid> m_costs;
+    /**
+     * @brief m_clusters The abstract graph of the level.
+     */
+    QSharedPointer<const ClusterGraph> m_clusters;
+    /**
+     * @brief m_pendingClusters The abstract graph while it is being built.
+     */
+    QFuture<QSharedPointer<const ClusterGraph>> m_pendingClusters;
+    /**
+     * @brief m_pendingLandmarks The landmark table while it is being built.
+     */
+    QFuture<QSharedPointer<const LandmarkTable>> m_pendingLandmarks;
+    /**
+     * @brief m_landmarks The landmark table of the level.
+     */
+    QSharedPointer<const LandmarkTable> m_landmarks;
+    /**
+     * @brief m_expansions The expansions of the last findPath().
+     */
+    int m_expansions = 0;
+    /**
+     * @brief m_isCanceled The function that stops the searches, empty for none.
+     */
+    std::function<bool()> m_isCanceled;
+    /**
+     * @brief m_canceled True once the last findPath() was stopped.
+     */
+    bool m_canceled = false;
+    /**
+     * @brief m_generation The current search, the cells with an older stamp have not been reached yet.
+     */
+    quint32 m_generation = 0;
+    /**
+     * @brief m_reached, m_closed The generation in which each cell was reached and closed.
+     */
+    std::vector<quint32> m_reached;
+    std::vector<quint32> m_closed;
+    /**
+     * @brief m_g The cost from the start to each cell, only valid if it was reached in this generation.
+     */
+    std::vector<float> m_g;
+    /**
+     * @brief m_parent The previous cell on the path to each cell.
+     */
+    std::vector<int> m_parent;
+    /**
+     * @brief m_open The open list, a binary heap that keeps its memory between searches.
+     */
+    std::vector<Entry> m_open;
+    /**
+     * @brief m_nodeGeneration, m_nodeReached, m_nodeClosed, m_nodeG, m_nodeParent The same arrays for the nodes
+     * of the graph. The node after the last one is the goal of the search.
+     */
+    quint32 m_nodeGeneration = 0;
+    std::vector<quint32> m_nodeReached;
+    std::vector<quint32> m_nodeClosed;
+    std::vector<float> m_nodeG;
+    std::vector<int> m_nodeParent;
+};
+
+#endif // PATHWORKSPACE_H
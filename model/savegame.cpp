@@ -0,0 +1,96 @@
+#include "savegame.h"
+#include "model/gamerandom.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+/// Header of a save file
+struct SavedHeader {
+    char magic[4];
+    quint32_le version;
+    quint32_le levels;
+    qint32_le currentLevel;
+    quint32_le seed;
+    quint32_le randomState;
+};
+
+constexpr char MAGIC[4] = {'Q', 'A', 'T', 'S'};
+
+/// The size of a block padded to 4 bytes
+constexpr qsizetype padded(qsizetype size) {
+    return (size + 3) & ~3;
+}
+} // namespace
+
+bool SaveGame::save(const QString &fileName) const {
+    QByteArray out;
+    SavedHeader header {{}, VERSION, (quint32)levels.size(), currentLevel, seed, (quint32)randomState.size()};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    out.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.append(randomState);
+    out.append(padded(randomState.size()) - randomState.size(), '\0');
+    for(const auto &level : levels) {
+        level.write(out);
+    }
+
+    QSaveFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit()) {
+        qDebug() << "Could not save the game to" << fileName;
+        return false;
+    }
+    return true;
+}
+
+bool SaveGame::load(const QString &fileName) {
+    levels.clear();
+    randomState.clear();
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Could not open the save" << fileName;
+        return false;
+    }
+
+    qint64 size = file.size();
+    const uchar *map = size >= (qint64)sizeof(SavedHeader) ? file.map(0, size) : nullptr;
+    if(!map) {
+        qDebug() << "Could not map the save" << fileName;
+        return false;
+    }
+
+    const uchar *data = map;
+    const uchar *end = map + size;
+    SavedHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    data += sizeof(header);
+
+    bool valid = !std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) && header.version == VERSION
+                 && header.currentLevel >= 0 && (quint32)header.currentLevel < header.levels
+                 && padded(header.randomState) <= end - data;
+    if(valid) {
+        randomState = QByteArray(reinterpret_cast<const char *>(data), header.randomState);
+        data += padded(header.randomState);
+        // Only a state the generator can go back to is loaded.
+        valid = GameRandom().restore(header.seed, randomState);
+    }
+    for(quint32 i = 0; valid && i < header.levels; ++i) {
+        LevelSnapshot level;
+        // Every level is played with its own protagonist, the current one right after loading.
+        valid = LevelSnapshot::read(data, end, level) && level.count(ObjectType::Protagonist) == 1;
+        levels.append(std::move(level));
+    }
+    file.unmap(const_cast<uchar *>(map));
+
+    if(!valid) {
+        qDebug() << "Invalid save" << fileName;
+        levels.clear();
+        randomState.clear();
+        return false;
+    }
+    currentLevel = header.currentLevel;
+    seed = header.seed;
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef SAVEGAME_H
+#define SAVEGAME_H
+
+#include <QList>
+#include <QString>
+
+#include "model/levelsnapshot.h"
+
+/**
+ * @brief The SaveGame class is the state of a whole game as it goes to disk: every level as a LevelSnapshot,
+ * the level being played and the GameRandom of the game. The protagonist is saved with the rest of the occupants
+ * of its level.
+ * The file is little endian: the magic "QATS", the format version, the number of levels, the current level,
+ * the seed and the size of the random state as 32 bit integers, the random state padded to 4 bytes, then the levels
+ * as written by LevelSnapshot::write().
+ */
+class SaveGame {
+public:
+    /**
+     * @brief VERSION The version of the format, files of other versions are not loaded.
+     */
+    static constexpr quint32 VERSION = 2;
+
+    /**
+     * @brief save Writes the game, the file is only replaced once it is complete.
+     * @param fileName The file to write.
+     * @return False if the file could not be written.
+     */
+    bool save(const QString &fileName) const;
+
+    /**
+     * @brief load Reads a game. The file is memory mapped and the tile arrays are copied out of it in bulk.
+     * @param fileName The file to read.
+     * @return False if the file could not be read or is not a valid save: a short file, another magic or version,
+     * a random state that cannot be read or a level without exactly one protagonist. The game is then left empty.
+     */
+    bool load(const QString &fileName);
+
+    /**
+     * @brief currentLevel The level being played.
+     */
+    int currentLevel = 0;
+    /**
+     * @brief levels All the levels of the game, by level number.
+     */
+    QList<LevelSnapshot> levels;
+    /**
+     * @brief seed, randomState The GameRandom of the game, from GameRandom::gameSeed() and GameRandom::state().
+     */
+    quint32 seed = 0;
+    QByteArray randomState;
+};
+
+#endif // SAVEGAME_H
@@ -0,0 +1,104 @@
+#include "spatialindex.h"
+#include "worldgrid.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+SpatialIndex::SpatialIndex(int columns, int rows)
+    : m_bucketColumns((columns + BUCKET_SIZE - 1) / BUCKET_SIZE)
+    , m_bucketRows((rows + BUCKET_SIZE - 1) / BUCKET_SIZE)
+    , m_counts(m_bucketColumns * m_bucketRows * 8, 0) {
+}
+
+void SpatialIndex::update(QPoint location, quint8 oldMask, quint8 newMask) {
+    quint8 changed = oldMask ^ newMask;
+    if(!changed) {
+        return;
+    }
+
+    int bucket = (location.x() / BUCKET_SIZE) * m_bucketRows + location.y() / BUCKET_SIZE;
+    for(int bit = 0; bit < 8; ++bit) {
+        if(changed & (1u << bit)) {
+            auto &count = m_counts[bucket * 8 + bit];
+            newMask & (1u << bit) ? ++count : --count;
+        }
+    }
+}
+
+bool SpatialIndex::bucketHas(int bx, int by, quint8 mask) const {
+    if(bx < 0 || by < 0 || bx >= m_bucketColumns || by >= m_bucketRows) {
+        return false;
+    }
+
+    const quint8 *counts = &m_counts[(bx * m_bucketRows + by) * 8];
+    for(int bit = 0; bit < 8; ++bit) {
+        if((mask & (1u << bit)) && counts[bit]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SpatialIndex::nearest(const WorldGrid &grid, QPoint location, quint8 mask) const {
+    int obx = location.x() / BUCKET_SIZE;
+    int oby = location.y() / BUCKET_SIZE;
+    int maxRing = std::max({obx, oby, m_bucketColumns - 1 - obx, m_bucketRows - 1 - oby});
+
+    int best = -1;
+    int bestDistance = INT_MAX;
+    double bestAngle = 0;
+
+    auto searchBucket = [&](int bx, int by) {
+        if(!bucketHas(bx, by, mask)) {
+            return;
+        }
+        int endX = std::min((bx + 1) * BUCKET_SIZE, grid.getColumnCount());
+        int endY = std::min((by + 1) * BUCKET_SIZE, grid.getRowCount());
+        for(int x = bx * BUCKET_SIZE; x < endX; ++x) {
+            for(int y = by * BUCKET_SIZE; y < endY; ++y) {
+                int cell = grid.index(x, y);
+                if(!(grid.occupants(cell) & mask)) {
+                    continue;
+                }
+                int dx = x - location.x();
+                int dy = y - location.y();
+                int distance = std::max(std::abs(dx), std::abs(dy));
+                if(!distance || distance > bestDistance) {
+                    continue;
+                }
+                // Same order as the angles of getAllNeighbors, the y axis points down.
+                double angle = std::atan2(-dy, dx) * 180 / M_PI;
+                if(angle < 0) {
+                    angle += 360;
+                }
+                if(distance < bestDistance || angle < bestAngle) {
+                    best = cell;
+                    bestDistance = distance;
+                    bestAngle = angle;
+                }
+            }
+        }
+    };
+
+    for(int r = 0; r <= maxRing; ++r) {
+        // A tile in a bucket r buckets away is at least (r - 1) * BUCKET_SIZE + 1 tiles away.
+        if((r - 1) * BUCKET_SIZE + 1 > bestDistance) {
+            break;
+        }
+
+        if(!r) {
+            searchBucket(obx, oby);
+            continue;
+        }
+        for(int bx = obx - r; bx <= obx + r; ++bx) {
+            searchBucket(bx, oby - r);
+            searchBucket(bx, oby + r);
+        }
+        for(int by = oby - r + 1; by <= oby + r - 1; ++by) {
+            searchBucket(obx - r, by);
+            searchBucket(obx + r, by);
+        }
+    }
+    return best;
+}
@@ -0,0 +1,71 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <vector>
+
+// Foward declaration of WorldGrid
+class WorldGrid;
+
+/**
+ * @brief The SpatialIndex class splits a level into square buckets of BUCKET_SIZE tiles and counts, for each
+ * bucket, how many tiles have each occupant type (the bits of the WorldGrid occupant mask).
+ * The WorldGrid updates it every time the occupant mask of a tile changes, which happens when objects
+ * move (parent change) or are destroyed. nearest() then only looks inside the buckets that have the
+ * type, from the closest ones outwards, and stops as soon as no other bucket can be closer.
+ */
+class SpatialIndex {
+public:
+    /**
+     * @brief BUCKET_SIZE The width and height of a bucket in tiles.
+     */
+    static constexpr int BUCKET_SIZE = 8;
+
+    /**
+     * @brief SpatialIndex constructor, all the buckets start empty.
+     * @param columns The number of columns of the level.
+     * @param rows The number of rows of the level.
+     */
+    SpatialIndex(int columns, int rows);
+
+    /**
+     * @brief update Updates the counts of the bucket of a tile after its occupant mask changed.
+     * @param location The tile.
+     * @param oldMask The occupant mask before the change.
+     * @param newMask The occupant mask after the change.
+     */
+    void update(QPoint location, quint8 oldMask, quint8 newMask);
+
+    /**
+     * @brief nearest Finds the closest tile (Chebyshev distance, the rings of getAllNeighbors) that has an occupant
+     * in the mask. The tile at location itself is not considered. Ties are broken by angle, starting from
+     * 0 deg like getAllNeighbors does.
+     * @param grid The grid with the occupant masks.
+     * @param location The tile to search from.
+     * @param mask The occupant types to look for.
+     * @return The index of the cell in the grid, -1 if there is none.
+     */
+    int nearest(const WorldGrid &grid, QPoint location, quint8 mask) const;
+
+private:
+    /**
+     * @brief bucketHas Checks if a bucket has any tile with one of the types in the mask.
+     */
+    bool bucketHas(int bx, int by, quint8 mask) const;
+
+    /**
+     * @brief m_bucketColumns The number of buckets along x.
+     */
+    int m_bucketColumns;
+    /**
+     * @brief m_bucketRows The number of buckets along y.
+     */
+    int m_bucketRows;
+    /**
+     * @brief m_counts Count of tiles per bucket and occupant bit, 8 counts per bucket.
+     */
+    std::vector<quint8> m_counts;
+};
+
+#endif // SPATIALINDEX_H
@@ -0,0 +1,46 @@
+#include "tickscheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+void TickScheduler::schedule(const QSharedPointer<Behavior> &behavior, int delay) {
+    if(behavior->isShared()) {
+        // A flyweight has no owner to tick for, and is shared by the levels of every thread.
+        return;
+    }
+
+    qint64 due = m_now + std::max(delay, 1);
+    if(behavior->m_nextTick > m_now && behavior->m_nextTick <= due) {
+        // Already waiting for a sooner tick.
+        return;
+    }
+
+    // A later entry left in the wheel is skipped when its slot comes, its tick no longer matches.
+    behavior->m_nextTick = due;
+    m_wheel[due % WHEEL_SIZE].append(behavior.toWeakRef());
+}
+
+void TickScheduler::advance() {
+    ++m_now;
+    int slot = m_now % WHEEL_SIZE;
+    // Behaviors scheduled from a tick() go into the fresh list, even for a full round.
+    auto entries = std::exchange(m_wheel[slot], {});
+
+    for(const auto &entry : entries) {
+        // The strong reference keeps the behavior alive even if its owner gets deleted during tick().
+        auto behavior = entry.toStrongRef();
+        if(!behavior) {
+            continue;
+        }
+
+        if(behavior->m_nextTick == m_now) {
+            behavior->m_nextTick = -1;
+            if(int delay = behavior->tick()) {
+                schedule(behavior, delay);
+            }
+        } else if(behavior->m_nextTick > m_now && behavior->m_nextTick % WHEEL_SIZE == slot) {
+            // Due in a later round.
+            m_wheel[slot].append(entry);
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef TICKSCHEDULER_H
+#define TICKSCHEDULER_H
+
+#include <QList>
+#include <QSharedPointer>
+#include <array>
+
+#include "model/behaviors/behavior.h"
+
+/**
+ * @brief The TickScheduler class hands out the game ticks of a level to the behaviors that asked for them.
+ * It is a timing wheel: a behavior that wants to be called again in N ticks goes into slot (now + N) % WHEEL_SIZE,
+ * so a tick only touches the behaviors that are due and never the objects that are idle.
+ * Delays longer than the wheel stay in their slot until the right round comes.
+ * Only weak references are kept, a behavior that is gone is dropped the next time its slot comes around.
+ */
+class TickScheduler {
+public:
+    /**
+     * @brief WHEEL_SIZE The number of slots of the wheel, longer delays take more than one round.
+     */
+    static constexpr int WHEEL_SIZE = 64;
+
+    /**
+     * @brief schedule Calls tick() on a behavior after a number of ticks. A behavior is only scheduled once,
+     * the sooner of the two delays is kept.
+     * @param behavior The behavior to call.
+     * @param delay The number of ticks, at least 1.
+     */
+    void schedule(const QSharedPointer<Behavior> &behavior, int delay = 1);
+
+    /**
+     * @brief advance Moves to the next tick and calls all the behaviors that are due.
+     */
+    void advance();
+
+    /**
+     * @brief now The number of ticks so far.
+     */
+    qint64 now() const {
+        return m_now;
+    }
+
+private:
+    /**
+     * @brief m_now The current tick.
+     */
+    qint64 m_now = 0;
+    /**
+     * @brief m_wheel The behaviors waiting in each slot.
+     */
+    std::array<QList<QWeakPointer<Behavior>>, WHEEL_SIZE> m_wheel;
+};
+
+#endif // TICKSCHEDULER_H
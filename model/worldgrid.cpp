@@ -0,0 +1,72 @@
+#include "worldgrid.h"
+
+WorldGrid::WorldGrid(int columns, int rows)
+    : m_columns(columns)
+    , m_rows(rows)
+    , m_energy(columns * rows, 0)
+    , m_poison(columns * rows, 0)
+    , m_path(columns * rows, 0)
+    , m_occupants(columns * rows, 0)
+    , m_tiles(columns * rows, nullptr)
+    , m_spatialIndex(columns, rows) {
+}
+
+QVariant WorldGrid::value(int index, DataRole role) const {
+    switch(role) {
+    case DataRole::Energy:
+        return get<DataRole::Energy>(index);
+    case DataRole::PoisonLevel:
+        return get<DataRole::PoisonLevel>(index);
+    case DataRole::Position:
+        return get<DataRole::Position>(index);
+    case DataRole::Path:
+        return get<DataRole::Path>(index);
+    default:
+        return QVariant();
+    }
+}
+
+void WorldGrid::setValue(int index, DataRole role, const QVariant &value) {
+    switch(role) {
+    case DataRole::Energy: {
+        float energy = value.toFloat();
+        if(m_energy[index] == energy) {
+            return;
+        }
+        m_energy[index] = energy;
+        break;
+    }
+    case DataRole::PoisonLevel: {
+        int poison = value.toInt();
+        if(m_poison[index] == poison) {
+            return;
+        }
+        m_poison[index] = poison;
+        break;
+    }
+    case DataRole::Path:
+        // Not a cost, the observers do not care.
+        m_path[index] = value.toBool();
+        return;
+    default:
+        // The position is the cell itself.
+        return;
+    }
+
+    for(auto *observer : m_observers) {
+        observer->costChanged(index);
+    }
+}
+
+void WorldGrid::setOccupants(int index, quint8 mask) {
+    quint8 oldMask = m_occupants[index];
+    if(oldMask == mask) {
+        return;
+    }
+
+    m_occupants[index] = mask;
+    m_spatialIndex.update(position(index), oldMask, mask);
+    for(auto *observer : m_observers) {
+        observer->occupantsChanged(index, oldMask, mask);
+    }
+}
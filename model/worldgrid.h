@@ -0,0 +1,275 @@
+#ifndef WORLDGRID_H
+#define WORLDGRID_H
+
+#include <QList>
+#include <QPair>
+#include <QPoint>
+#include <QVariant>
+#include <vector>
+
+#include "publicenums.h"
+#include "model/objectdata.h"
+#include "model/spatialindex.h"
+
+// Foward declaration of GameObject
+class GameObject;
+
+/**
+ * @brief The GridObserver class is the interface for whatever has to follow the changes of a WorldGrid,
+ * like the distance fields. Observers are notified right after the change is stored.
+ */
+class GridObserver {
+public:
+    virtual ~GridObserver() = default;
+    /**
+     * @brief occupantsChanged The occupant mask of a cell changed, something moved in or out or was destroyed.
+     * @param index The cell.
+     * @param oldMask The mask before the change.
+     * @param newMask The mask after the change.
+     */
+    virtual void occupantsChanged(int index, quint8 oldMask, quint8 newMask) = 0;
+    /**
+     * @brief costChanged The energy or the poison level of a cell changed.
+     * @param index The cell.
+     */
+    virtual void costChanged(int index) = 0;
+};
+
+/**
+ * @brief The WorldGrid class is the contiguous backing store of a level. It keeps the tile data
+ * in separate arrays (structure of arrays) in column-major order, index = x * rows + y.
+ * The tile GameObjects are thin views on this store: their energy, poison level, position and path mark
+ * are read and written here, and every cell keeps a bit mask of the types of its occupants.
+ * Scans over the whole map (getObject(type), nearest(), getAllData()) then walk linear memory
+ * and only touch the GameObjects of the cells that actually matter.
+ */
+class WorldGrid {
+public:
+    /**
+     * @brief OCCUPANT_TYPES The types that have a bit in the occupant mask, the bit is the index in this array.
+     */
+    static constexpr ObjectType OCCUPANT_TYPES[] = {
+      ObjectType::Doorway,
+      ObjectType::HealthPack,
+      ObjectType::Protagonist,
+      ObjectType::Enemy,
+      ObjectType::PoisonEnemy,
+      ObjectType::MovingEnemy,
+    };
+
+    /**
+     * @brief WorldGrid constructor, all the cells start empty.
+     * @param columns The number of columns of the level.
+     * @param rows The number of rows of the level.
+     */
+    WorldGrid(int columns, int rows);
+
+    /**
+     * @brief getColumnCount The number of columns (x) in the grid.
+     */
+    int getColumnCount() const {
+        return m_columns;
+    }
+
+    /**
+     * @brief getRowCount The number of rows (y) in the grid.
+     */
+    int getRowCount() const {
+        return m_rows;
+    }
+
+    /**
+     * @brief size The number of cells in the grid.
+     */
+    int size() const {
+        return m_columns * m_rows;
+    }
+
+    /**
+     * @brief contains Checks if a location is inside the grid.
+     * @return True if the cell exists.
+     */
+    bool contains(int x, int y) const {
+        return x >= 0 && y >= 0 && x < m_columns && y < m_rows;
+    }
+
+    /**
+     * @brief index The index of a cell in the arrays.
+     */
+    int index(int x, int y) const {
+        return x * m_rows + y;
+    }
+
+    /**
+     * @brief position The location of a cell from its index.
+     */
+    QPoint position(int index) const {
+        return {index / m_rows, index % m_rows};
+    }
+
+    /**
+     * @brief isGridRole Checks if a DataRole of a tile is stored in the grid instead of the tile itself.
+     * @param role The role to check.
+     * @return True for energy, poison level, position and the path mark.
+     */
+    static constexpr bool isGridRole(DataRole role) {
+        return role == DataRole::Energy || role == DataRole::PoisonLevel || role == DataRole::Position
+               || role == DataRole::Path;
+    }
+
+    /**
+     * @brief get Typed read of a grid role, same as GameObject::get().
+     * @param index The cell.
+     * @return The value of the role for that cell.
+     */
+    template <DataRole R>
+    ObjectData::RoleType<R> get(int index) const {
+        static_assert(isGridRole(R), "The role is not stored in the grid.");
+        if constexpr(R == DataRole::Energy) {
+            return m_energy[index];
+        } else if constexpr(R == DataRole::PoisonLevel) {
+            return m_poison[index];
+        } else if constexpr(R == DataRole::Path) {
+            return m_path[index] != 0;
+        } else {
+            return position(index);
+        }
+    }
+
+    /**
+     * @brief value Reads a grid role as a QVariant.
+     * @param index The cell.
+     * @param role The role to read, has to be a grid role.
+     * @return The value, invalid QVariant for other roles.
+     */
+    QVariant value(int index, DataRole role) const;
+
+    /**
+     * @brief setValue Writes a grid role from a QVariant. The position can not be written,
+     * it is given by the cell itself.
+     * @param index The cell.
+     * @param role The role to write, has to be a grid role.
+     * @param value The new value.
+     */
+    void setValue(int index, DataRole role, const QVariant &value);
+
+    /**
+     * @brief tile The tile GameObject of a cell, null if its chunk is cold (see ChunkMap).
+     */
+    GameObject *tile(int index) const {
+        return m_tiles[index];
+    }
+
+    /**
+     * @brief setTile Sets the tile GameObject of a cell.
+     */
+    void setTile(int index, GameObject *tile) {
+        m_tiles[index] = tile;
+    }
+
+    /**
+     * @brief occupants The occupant type mask of a cell.
+     */
+    quint8 occupants(int index) const {
+        return m_occupants[index];
+    }
+
+    /**
+     * @brief setOccupants Sets the occupant type mask of a cell, kept up to date by the tile when its children change.
+     * The spatial index is updated with the change.
+     */
+    void setOccupants(int index, quint8 mask);
+
+    /**
+     * @brief addObserver Registers an observer, it has to be removed before it is destroyed.
+     */
+    void addObserver(GridObserver *observer) {
+        m_observers.append(observer);
+    }
+
+    /**
+     * @brief removeObserver Unregisters an observer.
+     */
+    void removeObserver(GridObserver *observer) {
+        m_observers.removeOne(observer);
+    }
+
+    /**
+     * @brief nearest Finds the closest cell to a location with an occupant in the mask, see SpatialIndex::nearest.
+     * @param location The tile to search from, it is not considered itself.
+     * @param mask The occupant types to look for.
+     * @return The index of the cell, -1 if there is none.
+     */
+    int nearest(QPoint location, quint8 mask) const {
+        return m_spatialIndex.nearest(*this, location, mask);
+    }
+
+    /**
+     * @brief typeBit The bit of a type in the occupant mask.
+     * @param type The type of the occupant.
+     * @return The bit, 0 for types that are not occupants.
+     */
+    static constexpr quint8 typeBit(ObjectType type) {
+        for(int i = 0; i < (int)std::size(OCCUPANT_TYPES); ++i) {
+            if(OCCUPANT_TYPES[i] == type) {
+                return quint8(1u << i);
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief typeMask The mask of all the occupant types in a range, same ranges as GameObject::hasChild().
+     * @param range The first and last type, inclusive.
+     * @return The occupant mask.
+     */
+    static constexpr quint8 typeMask(QPair<ObjectType, ObjectType> range) {
+        quint8 mask = 0;
+        for(auto type : OCCUPANT_TYPES) {
+            if((int)type >= (int)range.first && (int)type <= (int)range.second) {
+                mask |= typeBit(type);
+            }
+        }
+        return mask;
+    }
+
+private:
+    /**
+     * @brief m_columns Number of columns.
+     */
+    int m_columns;
+    /**
+     * @brief m_rows Number of rows.
+     */
+    int m_rows;
+    /**
+     * @brief m_energy The energy of each tile.
+     */
+    std::vector<float> m_energy;
+    /**
+     * @brief m_poison The poison level of each tile.
+     */
+    std::vector<int> m_poison;
+    /**
+     * @brief m_path Whether each tile is on a path the protagonist was sent along, cold chunks keep their marks.
+     */
+    std::vector<quint8> m_path;
+    /**
+     * @brief m_occupants Bit mask of the types of the GameObjects on each tile.
+     */
+    std::vector<quint8> m_occupants;
+    /**
+     * @brief m_tiles The tile GameObject of each cell, null while the chunk of the cell is cold.
+     */
+    std::vector<GameObject *> m_tiles;
+    /**
+     * @brief m_spatialIndex Bucket counts of the occupant types, used by nearest().
+     */
+    SpatialIndex m_spatialIndex;
+    /**
+     * @brief m_observers The observers notified of every change.
+     */
+    QList<GridObserver *> m_observers;
+};
+
+#endif // WORLDGRID_H
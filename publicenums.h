@@ -40,6 +40,8 @@ namespace _pub {
         ChangeDirection,
 
         Path,
+
+        Id,
     };
     Q_ENUM_NS(DataRole);
 
@@ -0,0 +1,51 @@
+#include "allocationcounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<quint64> allocationCount {0};
+    std::atomic<quint64> freeCount {0};
+
+    void *allocate(std::size_t size) {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        if(void *memory = std::malloc(size ? size : 1)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    void release(void *memory) {
+        if(memory) {
+            freeCount.fetch_add(1, std::memory_order_relaxed);
+            std::free(memory);
+        }
+    }
+}
+
+quint64 AllocationCounter::allocations() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+quint64 AllocationCounter::frees() {
+    return freeCount.load(std::memory_order_relaxed);
+}
+
+// The replaced operators, the nothrow and sized ones of the standard library call these.
+// Nothing in the model is over-aligned, the aligned ones are left alone.
+void *operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void *memory) noexcept {
+    release(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    release(memory);
+}
@@ -0,0 +1,20 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+/**
+ * @brief The AllocationCounter namespace counts the heap allocations of the benchmarks. The benchmarks target replaces
+ * the global operator new and delete, so everything is counted: the GameObjects, Qt's own QObject data and the
+ * containers. Only the difference between two reads means something, Qt and QTest allocate too.
+ * Qt's allocations are only seen where the Qt libraries use the operators of the program, like on Linux. On Windows
+ * every DLL keeps its own and only the allocations of the model are counted.
+ */
+namespace AllocationCounter {
+    /// The number of calls to operator new so far
+    quint64 allocations();
+    /// The number of calls to operator delete with memory so far
+    quint64 frees();
+}
+
+#endif // ALLOCATIONCOUNTER_H
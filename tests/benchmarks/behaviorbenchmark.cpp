@@ -0,0 +1,54 @@
+#include "behaviorbenchmark.h"
+
+#include <QTest>
+
+#include "model/behaviors/attack.h"
+#include "model/behaviors/health.h"
+#include "model/behaviors/movement.h"
+#include "model/gameobjectmodel.h"
+#include "model/gameobjectsettings.h"
+#include "model/modelfactory.h"
+
+void BehaviorBenchmark::init() {
+    // A level of the default size, without enemies to get in the way.
+    m_model = ObjectModelFactory::createModel(0, 0, 0.5f, 0, 25, 40).first;
+    m_protagonist = m_model->getObject(ObjectType::Protagonist).at(0);
+}
+
+void BehaviorBenchmark::cleanup() {
+    delete m_model;
+}
+
+void BehaviorBenchmark::stepOn() {
+    int moves = 0;
+    QBENCHMARK {
+        // Around a square, turning and then moving each time, so the protagonist ends where it started.
+        for(Direction direction : {Direction::Right, Direction::Down, Direction::Left, Direction::Up}) {
+            m_protagonist->setData(DataRole::Energy, Movement::SETTINGS::MAX_ENERGY);
+            m_protagonist->getBehavior<Movement>()->stepOn(direction);
+            moves += m_protagonist->getBehavior<Movement>()->stepOn(direction);
+        }
+    }
+    QVERIFY(moves > 0);
+}
+
+void BehaviorBenchmark::attack() {
+    // An enemy right in front of the protagonist, it is healed after every attack so it never dies.
+    m_protagonist->getBehavior<Movement>()->stepOn(Direction::Right);
+    auto tile = m_protagonist->getNeighbor(Direction::Right);
+    QVERIFY(tile);
+    auto position = tile->get<DataRole::Position>();
+    m_model->addObject(position.x(), position.y(), GameObjectSettings::getDefaultData(ObjectType::Enemy));
+    auto enemy = m_model->getObject(position.x(), position.y(), ObjectType::Enemy);
+    QVERIFY(enemy);
+
+    int damage = 0;
+    QBENCHMARK {
+        damage += m_protagonist->getBehavior<Attack>()->attack();
+        enemy->setData(DataRole::Health, Health::SETTINGS::MAX_HEALTH);
+        // The counter attack and the strength the protagonist gains are undone too.
+        m_protagonist->setData(DataRole::Health, Health::SETTINGS::MAX_HEALTH);
+        m_protagonist->setData(DataRole::Strength, (float)Attack::SETTINGS::PLAYER_STRENGTH);
+    }
+    QVERIFY(damage > 0);
+}
@@ -0,0 +1,27 @@
+#ifndef BEHAVIORBENCHMARK_H
+#define BEHAVIORBENCHMARK_H
+
+#include <QObject>
+#include <QPointer>
+
+class GameObject;
+class GameObjectModel;
+
+/**
+ * @brief The BehaviorBenchmark class times the calls autoplay makes the most, a protagonist walking and attacking.
+ * Each call looks its behavior up on the GameObject like the controller does, so the slots are part of what is timed.
+ */
+class BehaviorBenchmark : public QObject {
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+    void stepOn();
+    void attack();
+
+private:
+    GameObjectModel *m_model = nullptr;
+    QPointer<GameObject> m_protagonist;
+};
+
+#endif // BEHAVIORBENCHMARK_H
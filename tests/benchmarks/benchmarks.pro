@@ -0,0 +1,25 @@
+# The benchmarks of the model, run the binary to get all of them or pass the name of a class to run only that one.
+# They are not part of make check, the big levels take a while.
+TARGET = benchmarks
+CONFIG += release
+
+include(../tests.pri)
+
+SOURCES += \
+    allocationcounter.cpp \
+    behaviorbenchmark.cpp \
+    main.cpp \
+    modelfactorybenchmark.cpp \
+    neighborbenchmark.cpp \
+    objectdatabenchmark.cpp \
+    pathfindingbenchmark.cpp \
+    savegamebenchmark.cpp
+
+HEADERS += \
+    allocationcounter.h \
+    behaviorbenchmark.h \
+    modelfactorybenchmark.h \
+    neighborbenchmark.h \
+    objectdatabenchmark.h \
+    pathfindingbenchmark.h \
+    savegamebenchmark.h
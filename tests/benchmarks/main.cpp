@@ -0,0 +1,40 @@
+#include <QCoreApplication>
+#include <QTest>
+
+#include "behaviorbenchmark.h"
+#include "modelfactorybenchmark.h"
+#include "neighborbenchmark.h"
+#include "objectdatabenchmark.h"
+#include "pathfindingbenchmark.h"
+#include "savegamebenchmark.h"
+
+/**
+ * Runs the benchmark classes one after the other. The first argument can name a class to run only that one,
+ * the other arguments are the ones of QTest, like the name of a function or -iterations.
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+
+    ObjectDataBenchmark objectData;
+    NeighborBenchmark neighbors;
+    BehaviorBenchmark behaviors;
+    ModelFactoryBenchmark modelFactory;
+    PathfindingBenchmark pathfinding;
+    SaveGameBenchmark saveGame;
+    const QList<QObject *> benchmarks {&objectData, &neighbors, &behaviors, &modelFactory, &pathfinding, &saveGame};
+
+    if(argc > 1 && argv[1][0] != '-') {
+        for(auto *benchmark : benchmarks) {
+            if(benchmark->metaObject()->className() == QByteArray(argv[1])) {
+                argv[1] = argv[0];
+                return QTest::qExec(benchmark, argc - 1, argv + 1);
+            }
+        }
+    }
+
+    int status = 0;
+    for(auto *benchmark : benchmarks) {
+        status |= QTest::qExec(benchmark, argc, argv);
+    }
+    return status;
+}
@@ -0,0 +1,119 @@
+#include "modelfactorybenchmark.h"
+
+#include <QElapsedTimer>
+#include <QTest>
+#include <numeric>
+
+#include "allocationcounter.h"
+#include "model/gameobjectmodel.h"
+#include "model/modelfactory.h"
+
+namespace {
+    /// The parameters of the first level at the given size, counted like GameController::levelParameters does.
+    LevelParameters parameters(int rows, int columns) {
+        int tiles = rows * columns;
+        unsigned int enemies = tiles / 20 + sqrt(tiles) / 10;
+        unsigned int healthPacks = sqrt(tiles) / 4;
+        return {0, enemies, healthPacks, 0.5f, rows, columns};
+    }
+}
+
+void ModelFactoryBenchmark::sizes() {
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<int>("columns");
+    QTest::newRow("40x25") << 25 << 40;
+    QTest::newRow("500x500") << 500 << 500;
+    QTest::newRow("2000x2000") << 2000 << 2000;
+}
+
+void ModelFactoryBenchmark::createLevelData_data() {
+    sizes();
+}
+
+void ModelFactoryBenchmark::createLevelData() {
+    QFETCH(int, rows);
+    QFETCH(int, columns);
+    // The part that runs on the LevelPregenerator thread, the heightmap, the costs and the placements.
+    LevelData data;
+    QBENCHMARK {
+        data = ObjectModelFactory::createLevelData(parameters(rows, columns));
+    }
+    QCOMPARE(data.heightmap.size(), size_t(rows * columns));
+}
+
+void ModelFactoryBenchmark::createModel_data() {
+    sizes();
+}
+
+void ModelFactoryBenchmark::createModel() {
+    QFETCH(int, rows);
+    QFETCH(int, columns);
+    // The models are only deleted after the timing, the deletion is not what is measured.
+    QList<GameObjectModel *> models;
+    QBENCHMARK {
+        models.append(ObjectModelFactory::createModel(ObjectModelFactory::createLevelData(parameters(rows, columns))).first);
+    }
+    QVERIFY(!models.isEmpty());
+    QCOMPARE(models.last()->getObject(ObjectType::Protagonist).size(), 1);
+    qDeleteAll(models);
+
+    // The allocations of one more model, the data is made first so only the GameObjects and the grid are counted.
+    // The landmarks of the level are built on a worker thread meanwhile, their few vectors can be counted too.
+    auto data = ObjectModelFactory::createLevelData(parameters(rows, columns));
+    quint64 allocations = AllocationCounter::allocations();
+    auto *model = ObjectModelFactory::createModel(std::move(data)).first;
+    qInfo() << "Allocations:" << AllocationCounter::allocations() - allocations;
+    delete model;
+}
+
+void ModelFactoryBenchmark::teardown_data() {
+    sizes();
+}
+
+void ModelFactoryBenchmark::teardown() {
+    QFETCH(int, rows);
+    QFETCH(int, columns);
+    // QBENCHMARK would time the making of the models too, only the deletes are timed here.
+    int runs = qBound(1, 1000000 / (rows * columns), 100);
+    qint64 nanoseconds = 0;
+    quint64 frees = 0;
+    for(int run = 0; run < runs; ++run) {
+        auto *model = ObjectModelFactory::createModel(ObjectModelFactory::createLevelData(parameters(rows, columns))).first;
+        quint64 before = AllocationCounter::frees();
+        QElapsedTimer timer;
+        timer.start();
+        delete model;
+        nanoseconds += timer.nsecsElapsed();
+        frees += AllocationCounter::frees() - before;
+    }
+    qInfo() << "Teardown:" << nanoseconds / runs / 1000000.0 << "ms," << frees / runs << "frees per model";
+}
+
+void ModelFactoryBenchmark::pickCells_data() {
+    QTest::addColumn<int>("side");
+    QTest::addColumn<int>("count");
+    // As many as the controller asks for, and then every cell, the worst case for picking at random.
+    for(int side : {40, 500, 2000}) {
+        QTest::addRow("%dx%d enemies", side, side) << side << side * side / 20;
+        QTest::addRow("%dx%d all", side, side) << side << side * side;
+    }
+}
+
+void ModelFactoryBenchmark::pickCells() {
+    QFETCH(int, side);
+    QFETCH(int, count);
+    int cells = side * side;
+    std::vector<quint32> all(cells);
+    std::iota(all.begin(), all.end(), 0);
+    QList<QPoint> picked;
+    GameRandom random;
+    QBENCHMARK {
+        // The copy is linear too, it is there so every run picks from the full level.
+        auto candidates = all;
+        picked = ObjectModelFactory::pickCells(candidates, side, count, random);
+    }
+    QCOMPARE(picked.size(), count);
+    // Asking for more than there is ends with every cell, it does not keep trying.
+    auto candidates = all;
+    QCOMPARE(ObjectModelFactory::pickCells(candidates, side, cells + 1, random).size(), cells);
+}
@@ -0,0 +1,29 @@
+#ifndef MODELFACTORYBENCHMARK_H
+#define MODELFACTORYBENCHMARK_H
+
+#include <QObject>
+
+/**
+ * @brief The ModelFactoryBenchmark class times the making of a level, first only the data and then the whole model,
+ * from the default size up to the biggest one, with as many enemies and health packs as the controller would ask for.
+ * The heap allocations of making a model and the time and frees of deleting one are printed too.
+ * The placement is also timed on its own, picking from a few to all of the cells of the level.
+ */
+class ModelFactoryBenchmark : public QObject {
+    Q_OBJECT
+private slots:
+    void createLevelData_data();
+    void createLevelData();
+    void createModel_data();
+    void createModel();
+    void teardown_data();
+    void teardown();
+    void pickCells_data();
+    void pickCells();
+
+private:
+    /// The sizes of the levels that are timed.
+    void sizes();
+};
+
+#endif // MODELFACTORYBENCHMARK_H
@@ -0,0 +1,58 @@
+#include "neighborbenchmark.h"
+
+#include <QTest>
+
+#include "model/gameobjectmodel.h"
+#include "model/modelfactory.h"
+#include "model/neighbortable.h"
+
+namespace {
+    /// In the middle of the level, so every ring that is timed is inside of it.
+    constexpr QPoint CENTER(75, 75);
+}
+
+void NeighborBenchmark::initTestCase() {
+    m_model = ObjectModelFactory::createModel(0, 0, 0.5f, 0, 150, 150).first;
+}
+
+void NeighborBenchmark::cleanupTestCase() {
+    delete m_model;
+}
+
+void NeighborBenchmark::offsets() {
+    QTest::addColumn<int>("offset");
+    for(int offset : {0, 1, 4, 16, 64}) {
+        QTest::addRow("offset %d", offset) << offset;
+    }
+}
+
+void NeighborBenchmark::geometric_data() {
+    offsets();
+}
+
+void NeighborBenchmark::geometric() {
+    QFETCH(int, offset);
+    QList<QPointer<GameObject>> ring;
+    QBENCHMARK {
+        // What GameObject::getAllNeighbors did before the NeighborTable, one getNeighbor per angle.
+        ring.clear();
+        for(double i = 0; i < 360; i += 360 / (((double)offset + 1) * 8)) {
+            QPoint point = CENTER + GameObjectModel::geometricNeighbor(i, offset);
+            ring.append(m_model->getObject(point.x(), point.y(), ObjectType::Tile));
+        }
+    }
+    QCOMPARE(ring, m_model->getAllNeighbors(CENTER, offset));
+}
+
+void NeighborBenchmark::table_data() {
+    offsets();
+}
+
+void NeighborBenchmark::table() {
+    QFETCH(int, offset);
+    QList<QPointer<GameObject>> ring;
+    QBENCHMARK {
+        ring = m_model->getAllNeighbors(CENTER, offset);
+    }
+    QCOMPARE(ring.size(), (qsizetype)NeighborTable::ringSize(offset));
+}
@@ -0,0 +1,29 @@
+#ifndef NEIGHBORBENCHMARK_H
+#define NEIGHBORBENCHMARK_H
+
+#include <QObject>
+
+class GameObjectModel;
+
+/**
+ * @brief The NeighborBenchmark class times getAllNeighbors from the middle of a level, as it is now (the rings
+ * of the NeighborTable) and as it was (one QTransform/QLineF intersection and tile lookup per angle).
+ */
+class NeighborBenchmark : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void geometric_data();
+    void geometric();
+    void table_data();
+    void table();
+
+private:
+    /// The offsets of the rings that are timed.
+    void offsets();
+
+    GameObjectModel *m_model = nullptr;
+};
+
+#endif // NEIGHBORBENCHMARK_H
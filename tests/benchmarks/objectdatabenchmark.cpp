@@ -0,0 +1,81 @@
+#include "objectdatabenchmark.h"
+
+#include <QTest>
+
+#include "model/gameobject.h"
+#include "model/gameobjectsettings.h"
+#include "model/objectdata.h"
+
+namespace {
+    constexpr int READS = 1000;
+
+    /// The data of a protagonist, like the factory makes it.
+    ObjectData protagonistData() {
+        auto data = GameObjectSettings::getDefaultData(ObjectType::Protagonist);
+        data.set<DataRole::Position>(QPoint(3, 4));
+        return data;
+    }
+}
+
+void ObjectDataBenchmark::typedSlots() {
+    auto data = protagonistData();
+    float sum = 0;
+    QBENCHMARK {
+        for(int i = 0; i < READS; ++i) {
+            sum += data.get<DataRole::Energy>() + data.get<DataRole::Health>() + data.get<DataRole::PoisonLevel>()
+                   + data.get<DataRole::Position>().x() + (int)data.get<DataRole::Direction>();
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void ObjectDataBenchmark::variantShim() {
+    auto data = protagonistData();
+    float sum = 0;
+    QBENCHMARK {
+        for(int i = 0; i < READS; ++i) {
+            sum += data.value(DataRole::Energy).toFloat() + data.value(DataRole::Health).toInt()
+                   + data.value(DataRole::PoisonLevel).toInt() + data.value(DataRole::Position).toPoint().x()
+                   + data.value(DataRole::Direction).toInt();
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void ObjectDataBenchmark::variantMap() {
+    auto data = protagonistData().toMap();
+    float sum = 0;
+    QBENCHMARK {
+        for(int i = 0; i < READS; ++i) {
+            sum += data.value(DataRole::Energy).toFloat() + data.value(DataRole::Health).toInt()
+                   + data.value(DataRole::PoisonLevel).toInt() + data.value(DataRole::Position).toPoint().x()
+                   + data.value(DataRole::Direction).toInt();
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void ObjectDataBenchmark::gameObjectTyped() {
+    GameObject object(protagonistData().toMap());
+    float sum = 0;
+    QBENCHMARK {
+        for(int i = 0; i < READS; ++i) {
+            sum += object.get<DataRole::Energy>() + object.get<DataRole::Health>() + object.get<DataRole::PoisonLevel>()
+                   + object.get<DataRole::Position>().x() + (int)object.get<DataRole::Direction>();
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void ObjectDataBenchmark::gameObjectVariant() {
+    GameObject object(protagonistData().toMap());
+    float sum = 0;
+    QBENCHMARK {
+        for(int i = 0; i < READS; ++i) {
+            sum += object.getData(DataRole::Energy).toFloat() + object.getData(DataRole::Health).toInt()
+                   + object.getData(DataRole::PoisonLevel).toInt() + object.getData(DataRole::Position).toPoint().x()
+                   + object.getData(DataRole::Direction).toInt();
+        }
+    }
+    QVERIFY(sum > 0);
+}
@@ -0,0 +1,21 @@
+#ifndef OBJECTDATABENCHMARK_H
+#define OBJECTDATABENCHMARK_H
+
+#include <QObject>
+
+/**
+ * @brief The ObjectDataBenchmark class compares reading the data of a GameObject through the typed slots of
+ * ObjectData with the QVariant shim on top of them and with the QMap<DataRole, QVariant> the objects used to keep.
+ * Every benchmark reads the roles a step of GenericMoveBehavior::stepOn reads, 1000 times.
+ */
+class ObjectDataBenchmark : public QObject {
+    Q_OBJECT
+private slots:
+    void typedSlots();
+    void variantShim();
+    void variantMap();
+    void gameObjectTyped();
+    void gameObjectVariant();
+};
+
+#endif // OBJECTDATABENCHMARK_H
@@ -0,0 +1,163 @@
+#include "pathfindingbenchmark.h"
+
+#include <QRandomGenerator>
+#include <QTest>
+
+#include "model/pathfinding/dstarlite.h"
+#include "model/pathfinding/landmarktable.h"
+#include "model/pathfinding/pathworkspace.h"
+
+namespace {
+    /// The side of the level, ClusterGraph::SETTINGS::MIN_CELLS <= SIDE * SIDE <= LandmarkTable::SETTINGS::MAX_CELLS.
+    constexpr int SIDE = 512;
+    /// The side of the level of the replanning, small enough to be searched without the ClusterGraph.
+    constexpr int PLANNER_SIDE = 200;
+    /// The replanning walks from the entry to the exit of its level.
+    constexpr QPoint START(0, 0);
+    constexpr QPoint GOAL(PLANNER_SIDE - 1, PLANNER_SIDE - 1);
+    /// The number of start and goal pairs.
+    constexpr int PAIRS = 50;
+    /// The pairs are the same every run.
+    constexpr quint32 SEED = 2024;
+
+    /// The cost of a path, every tile but the first one is stepped onto.
+    float pathCost(const CostGrid &costs, const std::vector<int> &path) {
+        float cost = 0;
+        for(size_t i = 1; i < path.size(); ++i) {
+            cost += costs.cost(path[i]);
+        }
+        return cost;
+    }
+}
+
+void PathfindingBenchmark::initTestCase() {
+    m_level = ObjectModelFactory::createLevelData({0, 0, 0, 0.5f, SIDE, SIDE});
+    QVERIFY(m_level.clusters);
+
+    const auto &costs = *m_level.costs;
+    QRandomGenerator random(SEED);
+    PathWorkspace workspace(m_level.costs);
+    for(int tries = 0; (int)m_pairs.size() < PAIRS && tries < 100 * PAIRS; ++tries) {
+        int from = random.bounded(costs.size());
+        int to = random.bounded(costs.size());
+        if(from == to || std::isinf(costs.cost(from)) || std::isinf(costs.cost(to))) {
+            continue;
+        }
+        auto path = workspace.findPath(from, to);
+        if(path.empty()) {
+            continue;
+        }
+        m_pairs.push_back({from, to});
+        m_optimal.push_back(pathCost(costs, path));
+        m_flatExpansions += workspace.expansions();
+    }
+    QCOMPARE((int)m_pairs.size(), PAIRS);
+}
+
+void PathfindingBenchmark::flat() {
+    // What the levels without a ClusterGraph or a LandmarkTable run, and what big levels used to run.
+    PathWorkspace workspace(m_level.costs);
+    QBENCHMARK {
+        for(auto [from, to] : m_pairs) {
+            workspace.findPath(from, to);
+        }
+    }
+    qInfo() << "A*:" << m_flatExpansions / PAIRS << "expansions per search";
+}
+
+void PathfindingBenchmark::hierarchical() {
+    PathWorkspace workspace(m_level.costs, m_level.clusters);
+    QBENCHMARK {
+        for(auto [from, to] : m_pairs) {
+            workspace.findPath(from, to);
+        }
+    }
+
+    // The paths of the graph can cost more than the cheapest ones, never less.
+    double totalError = 0;
+    double maxError = 0;
+    qint64 expansions = 0;
+    for(size_t i = 0; i < m_pairs.size(); ++i) {
+        auto path = workspace.findPath(m_pairs[i].first, m_pairs[i].second);
+        QVERIFY(!path.empty());
+        expansions += workspace.expansions();
+        double error = (pathCost(*m_level.costs, path) - m_optimal[i]) / m_optimal[i];
+        QVERIFY(error > -1e-4);
+        totalError += error;
+        maxError = qMax(maxError, error);
+    }
+    qInfo() << "HPA*:" << expansions / PAIRS << "expansions per search, path cost error mean"
+            << 100 * totalError / PAIRS << "% max" << 100 * maxError << "%";
+}
+
+void PathfindingBenchmark::landmarkTable() {
+    // What runs on a worker thread after every level is made.
+    QSharedPointer<const LandmarkTable> table;
+    QBENCHMARK {
+        table = LandmarkTable::build(m_level.costs);
+    }
+    QVERIFY(table);
+}
+
+void PathfindingBenchmark::landmarks() {
+    PathWorkspace workspace(m_level.costs);
+    auto table = LandmarkTable::buildLater(m_level.costs);
+    table.waitForFinished();
+    workspace.setLandmarks(table);
+    QBENCHMARK {
+        for(auto [from, to] : m_pairs) {
+            workspace.findPath(from, to);
+        }
+    }
+
+    // The landmarks never overestimate, the paths stay the cheapest ones.
+    qint64 expansions = 0;
+    for(size_t i = 0; i < m_pairs.size(); ++i) {
+        auto path = workspace.findPath(m_pairs[i].first, m_pairs[i].second);
+        expansions += workspace.expansions();
+        QVERIFY(qAbs(pathCost(*m_level.costs, path) - m_optimal[i]) <= 1e-4 * m_optimal[i]);
+    }
+    qInfo() << "ALT:" << expansions / PAIRS << "expansions per search,"
+            << (double)m_flatExpansions / qMax<qint64>(expansions, 1) << "times fewer than A*";
+}
+
+void PathfindingBenchmark::search() {
+    // What the controller did when the level changed under a path: search the whole way again.
+    auto [model, workspace] = ObjectModelFactory::createModel(0, 0, 0.5f, 0, PLANNER_SIDE, PLANNER_SIDE);
+    std::vector<int> path;
+    QBENCHMARK {
+        path = workspace->findPath(START, GOAL);
+    }
+    QVERIFY(!path.empty());
+    qInfo() << "A* from scratch:" << workspace->expansions() << "expansions";
+    delete model;
+}
+
+void PathfindingBenchmark::replan() {
+    auto model = ObjectModelFactory::createModel(0, 0, 0.5f, 0, PLANNER_SIDE, PLANNER_SIDE).first;
+    auto &planner = model->getPlanner();
+    planner.setGoal(GOAL);
+    auto moves = planner.path(START);
+    QVERIFY(!moves.empty());
+
+    // A tile halfway along the way gets poisoned and cleaned again, the planner repairs the tree each time.
+    QPoint position = START;
+    for(size_t i = 0; i < moves.size() / 2; ++i) {
+        position += CostGrid::MOVES[moves[i]];
+    }
+    auto tile = model->getObject(position.x(), position.y(), ObjectType::Tile);
+    QVERIFY(tile);
+    int poison = 0;
+    qint64 expansions = 0;
+    qint64 replans = 0;
+    QBENCHMARK {
+        poison = poison ? 0 : 100;
+        tile->setData(DataRole::PoisonLevel, poison);
+        moves = planner.path(START);
+        expansions += planner.expansions();
+        ++replans;
+    }
+    QVERIFY(!moves.empty());
+    qInfo() << "D* Lite:" << expansions / replans << "expansions per replan";
+    delete model;
+}
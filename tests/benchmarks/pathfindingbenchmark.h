@@ -0,0 +1,37 @@
+#ifndef PATHFINDINGBENCHMARK_H
+#define PATHFINDINGBENCHMARK_H
+
+#include <QObject>
+#include <vector>
+
+#include "model/modelfactory.h"
+
+/**
+ * @brief The PathfindingBenchmark class times the searches of PathWorkspace between random tiles of one level:
+ * the flat A*, the ClusterGraph (HPA*) and the landmarks (ALT). It prints how much more the HPA* paths cost
+ * than the cheapest ones and how many tiles ALT saves. The replanning of DStarLite after a tile changes is timed
+ * against searching the whole way again.
+ */
+class PathfindingBenchmark : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void flat();
+    void hierarchical();
+    void landmarkTable();
+    void landmarks();
+    void search();
+    void replan();
+
+private:
+    /// The level the searches run on, big enough to get a ClusterGraph and small enough to get a LandmarkTable.
+    LevelData m_level;
+    /// The tiles the searches go from and to, every goal can be reached from its start.
+    std::vector<std::pair<int, int>> m_pairs;
+    /// The cost of the cheapest path of every pair.
+    std::vector<float> m_optimal;
+    /// The tiles the flat A* expands for all of the pairs.
+    qint64 m_flatExpansions = 0;
+};
+
+#endif // PATHFINDINGBENCHMARK_H
@@ -0,0 +1,61 @@
+#include "savegamebenchmark.h"
+
+#include <QFileInfo>
+#include <QTest>
+
+#include "model/gamerandom.h"
+#include "model/modelfactory.h"
+
+namespace {
+    /// The side of the level, the biggest one the game makes
+    constexpr int SIDE = LevelSnapshot::SETTINGS::MAX_SIDE;
+}
+
+void SaveGameBenchmark::initTestCase() {
+    QVERIFY(m_dir.isValid());
+    // As many enemies and health packs as GameController::levelParameters asks for on the first level.
+    int tiles = SIDE * SIDE;
+    m_model = ObjectModelFactory::createModel(tiles / 20 + sqrt(tiles) / 10, sqrt(tiles) / 4, 0.5f, 0, SIDE, SIDE, 1).first;
+    m_save.levels.append(LevelSnapshot::capture(*m_model));
+    m_save.randomState = GameRandom().state();
+}
+
+void SaveGameBenchmark::cleanupTestCase() {
+    delete m_model;
+}
+
+void SaveGameBenchmark::capture() {
+    LevelSnapshot snapshot;
+    QBENCHMARK {
+        snapshot = LevelSnapshot::capture(*m_model);
+    }
+    QCOMPARE(snapshot.count(ObjectType::Protagonist), 1);
+}
+
+void SaveGameBenchmark::save() {
+    QString fileName = m_dir.filePath("save.sav");
+    QBENCHMARK {
+        QVERIFY(m_save.save(fileName));
+    }
+    qInfo() << "Save file bytes:" << QFileInfo(fileName).size();
+}
+
+void SaveGameBenchmark::load() {
+    QString fileName = m_dir.filePath("load.sav");
+    QVERIFY(m_save.save(fileName));
+    SaveGame loaded;
+    QBENCHMARK {
+        QVERIFY(loaded.load(fileName));
+    }
+    QCOMPARE(loaded.levels.size(), 1);
+}
+
+void SaveGameBenchmark::restore() {
+    // The models are only deleted after the timing, the deletion is not what is measured.
+    QList<GameObjectModel *> models;
+    QBENCHMARK {
+        models.append(m_save.levels[0].restore().first);
+    }
+    QCOMPARE(models.last()->getObject(ObjectType::Protagonist).size(), 1);
+    qDeleteAll(models);
+}
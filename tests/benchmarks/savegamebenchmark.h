@@ -0,0 +1,33 @@
+#ifndef SAVEGAMEBENCHMARK_H
+#define SAVEGAMEBENCHMARK_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+#include "model/savegame.h"
+
+/**
+ * @brief The SaveGameBenchmark class times saving and loading a game of one level of the biggest size, 2000x2000,
+ * with as many enemies and health packs as the controller would ask for. The snapshot of the level and its
+ * restore are timed on their own, they are what the controller does around SaveGame::save() and SaveGame::load().
+ */
+class SaveGameBenchmark : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void capture();
+    void save();
+    void load();
+    void restore();
+
+private:
+    /// The level that is saved
+    GameObjectModel *m_model = nullptr;
+    /// The game of that level
+    SaveGame m_save;
+    /// Where the save file is written
+    QTemporaryDir m_dir;
+};
+
+#endif // SAVEGAMEBENCHMARK_H
@@ -0,0 +1,8 @@
+# Checks the paths DStarLite repairs against a search of the whole level as it is.
+TARGET = tst_dstarlite
+CONFIG += testcase
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_dstarlite.cpp
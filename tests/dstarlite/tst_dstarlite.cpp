@@ -0,0 +1,168 @@
+#include <QRandomGenerator>
+#include <QTest>
+#include <cmath>
+
+#include "model/distancefield.h"
+#include "model/gameobjectmodel.h"
+#include "model/gameobjectsettings.h"
+#include "model/pathfinding/costgrid.h"
+#include "model/pathfinding/dstarlite.h"
+#include "model/pathfinding/pathworkspace.h"
+
+/**
+ * @brief The TestDStarLite class checks that the repairs of DStarLite give the cheapest path. A level is changed
+ * along and around the path again and again: poison comes and goes, enemies and health packs appear and
+ * disappear, and the start moves on. After every change the cost of path() is compared with a Dijkstra of
+ * PathWorkspace on a CostGrid made from the live level.
+ */
+class TestDStarLite : public QObject {
+    Q_OBJECT
+private slots:
+    void repairs_data();
+    void repairs();
+
+private:
+    /// The cost of stepping onto every tile of the level as it is now, the way DStarLite counts it.
+    static QSharedPointer<CostGrid> liveCosts(const GameObjectModel &model);
+    /// Changes a tile: its poison, or the enemy or health pack standing on it.
+    static void change(GameObjectModel &model, QPoint cell, QRandomGenerator &random);
+};
+
+QSharedPointer<CostGrid> TestDStarLite::liveCosts(const GameObjectModel &model) {
+    int columns = model.getColumnCount();
+    int rows = model.getRowCount();
+    auto costs = QSharedPointer<CostGrid>::create(columns, rows);
+    for(int x = 0; x < columns; ++x) {
+        for(int y = 0; y < rows; ++y) {
+            float cost = model.getTileData<DataRole::Energy>(x, y);
+            if(model.getObject(x, y, ObjectType::HealthPack)) {
+                cost = CostGrid::SETTINGS::HEALTH_PACK_COST;
+            } else if(model.getObject(x, y, ObjectType::Enemy) || model.getObject(x, y, ObjectType::PoisonEnemy)
+                      || model.getObject(x, y, ObjectType::MovingEnemy)) {
+                cost = CostGrid::SETTINGS::ENEMY_COST;
+            }
+            if(std::isinf(model.getTileData<DataRole::Energy>(x, y))) {
+                cost = INFINITY;
+            }
+            costs->setTerrain(x, y, cost + model.getTileData<DataRole::PoisonLevel>(x, y) * DistanceField::SETTINGS::POISON_COST);
+        }
+    }
+    return costs;
+}
+
+void TestDStarLite::change(GameObjectModel &model, QPoint cell, QRandomGenerator &random) {
+    int x = cell.x();
+    int y = cell.y();
+    if(x < 0 || y < 0 || x >= model.getColumnCount() || y >= model.getRowCount()
+       || std::isinf(model.getTileData<DataRole::Energy>(x, y)) || model.getObject(x, y, ObjectType::Protagonist)) {
+        return;
+    }
+    switch(random.bounded(4)) {
+    case 0:
+    case 1:
+        // Poisoned, or cleaned up by the protagonist.
+        model.getObject(x, y, ObjectType::Tile)->setData(DataRole::PoisonLevel, random.bounded(2) ? random.bounded(1, 100) : 0);
+        break;
+    case 2:
+        // Something is killed or picked up.
+        for(auto type : {ObjectType::Enemy, ObjectType::PoisonEnemy, ObjectType::MovingEnemy, ObjectType::HealthPack}) {
+            if(auto object = model.getObject(x, y, type)) {
+                delete object.data();
+                return;
+            }
+        }
+        [[fallthrough]];
+    default:
+        // Something new on a free tile.
+        if(!model.getObject(x, y, ObjectType::Enemy) && !model.getObject(x, y, ObjectType::PoisonEnemy)
+           && !model.getObject(x, y, ObjectType::MovingEnemy) && !model.getObject(x, y, ObjectType::HealthPack)) {
+            auto type = random.bounded(2) ? ObjectType::Enemy : ObjectType::HealthPack;
+            model.addObject(x, y, GameObjectSettings::getDefaultData(type));
+        }
+        break;
+    }
+}
+
+void TestDStarLite::repairs_data() {
+    QTest::addColumn<int>("side");
+    QTest::addColumn<quint32>("seed");
+    for(int side : {30, 120}) {
+        for(quint32 seed = 1; seed <= 4; ++seed) {
+            QTest::addRow("%dx%d seed %u", side, side, seed) << side << seed;
+        }
+    }
+}
+
+void TestDStarLite::repairs() {
+    QFETCH(int, side);
+    QFETCH(quint32, seed);
+    QRandomGenerator random(seed);
+
+    // A level with a few walls, enemies and health packs, made like LevelSnapshot::restore() makes one.
+    GameObjectModel model(side, side);
+    for(int y = 0; y < side; ++y) {
+        for(int x = 0; x < side; ++x) {
+            bool wall = random.bounded(10) == 0 && QPoint(x, y) != QPoint(0, 0) && QPoint(x, y) != QPoint(side - 1, side - 1);
+            model.setTerrain(x, y, wall ? INFINITY : random.bounded(1, 256) / 255.0f, random.bounded(8) ? 0 : random.bounded(50));
+        }
+    }
+    model.addObject(0, 0, GameObjectSettings::getDefaultData(ObjectType::Protagonist));
+    for(int i = 0; i < side * side / 20; ++i) {
+        QPoint cell(random.bounded(side), random.bounded(side));
+        change(model, cell, random);
+    }
+    model.updateChunks();
+
+    auto &planner = model.getPlanner();
+    QPoint goal(side - 1, side - 1);
+    planner.setGoal(goal);
+    QPoint start(0, 0);
+    const QRect area(0, 0, side, side);
+
+    for(int round = 0; round < 60; ++round) {
+        auto path = planner.path(start);
+
+        // The cheapest cost from the start to the goal on the level as it is now.
+        auto costs = liveCosts(model);
+        PathWorkspace workspace(costs);
+        workspace.explore(costs->index(goal.x(), goal.y()), area, true);
+        float cheapest = workspace.distance(costs->index(start.x(), start.y()));
+
+        float cost = 0;
+        QPoint cell = start;
+        for(int move : path) {
+            cell += CostGrid::MOVES[move];
+            QVERIFY(costs->contains(cell.x(), cell.y()));
+            cost += costs->cost(costs->index(cell.x(), cell.y()));
+        }
+        if(std::isinf(cheapest)) {
+            QVERIFY(path.empty());
+        } else {
+            QVERIFY(start == goal || !path.empty());
+            QCOMPARE(cell, goal);
+            QVERIFY2(qAbs(cost - cheapest) <= 1e-4f * cheapest + 1e-4f,
+                     qPrintable(QString("round %1: path costs %2, cheapest %3").arg(round).arg(cost).arg(cheapest)));
+        }
+        if(path.empty()) {
+            break;
+        }
+        QCOMPARE(planner.nextMove(start), path.front());
+
+        // The walk goes on a few steps, then the level changes on the path and next to it.
+        for(int step = 0; step < 3 && step < (int)path.size(); ++step) {
+            start += CostGrid::MOVES[path[step]];
+        }
+        for(int i = 0; i < 6; ++i) {
+            QPoint on = start;
+            int along = random.bounded((int)path.size());
+            for(int step = 3; step < along; ++step) {
+                on += CostGrid::MOVES[path[step]];
+            }
+            QPoint next(on.x() + random.bounded(-2, 3), on.y() + random.bounded(-2, 3));
+            change(model, i % 2 ? on : next, random);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestDStarLite)
+#include "tst_dstarlite.moc"
@@ -0,0 +1,8 @@
+# Checks the NeighborTable against the ray/ring intersection it replaced.
+TARGET = tst_neighbortable
+CONFIG += testcase
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_neighbortable.cpp
@@ -0,0 +1,83 @@
+#include <QTest>
+
+#include "model/gameobjectmodel.h"
+#include "model/modelfactory.h"
+#include "model/neighbortable.h"
+
+/**
+ * @brief The TestNeighborTable class checks that the NeighborTable gives the tiles the QTransform/QLineF
+ * intersection of GameObjectModel::geometricNeighbor gives, for every angle getNeighbor and getAllNeighbors use.
+ */
+class TestNeighborTable : public QObject {
+    Q_OBJECT
+private slots:
+    void compass_data();
+    void compass();
+    void ring_data();
+    void ring();
+    void modelRing();
+
+private:
+    /// The offsets 0 to 64, one row each.
+    void offsets();
+};
+
+void TestNeighborTable::offsets() {
+    QTest::addColumn<int>("offset");
+    for(int offset = 0; offset <= 64; ++offset) {
+        QTest::addRow("offset %d", offset) << offset;
+    }
+}
+
+void TestNeighborTable::compass_data() {
+    offsets();
+}
+
+void TestNeighborTable::compass() {
+    QFETCH(int, offset);
+    for(int direction = 0; direction < 360; direction += 45) {
+        QPoint point;
+        QVERIFY(NeighborTable::offset(direction, offset, &point));
+        QCOMPARE(point, GameObjectModel::geometricNeighbor(direction, offset));
+    }
+}
+
+void TestNeighborTable::ring_data() {
+    offsets();
+}
+
+void TestNeighborTable::ring() {
+    QFETCH(int, offset);
+    auto ring = NeighborTable::ring(offset);
+    int k = 0;
+    // The angles getAllNeighbors always visited, with the same double accumulation.
+    for(double i = 0; i < 360; i += 360 / (((double)offset + 1) * 8)) {
+        QVERIFY(k < (int)ring.size());
+        QCOMPARE(ring[k], GameObjectModel::geometricNeighbor(i, offset));
+        ++k;
+    }
+    QCOMPARE(k, (int)ring.size());
+    QCOMPARE(k, NeighborTable::ringSize(offset));
+}
+
+void TestNeighborTable::modelRing() {
+    // The model gives the tiles of the ring, and null for the ones outside of the level, in the order of the angles.
+    auto model = ObjectModelFactory::createModel(0, 0, 0.5f, 0, 20, 30);
+    for(QPoint location : {QPoint(0, 0), QPoint(10, 7), QPoint(29, 19)}) {
+        for(int offset = 0; offset < 4; ++offset) {
+            auto ring = model.first->getAllNeighbors(location, offset);
+            int k = 0;
+            for(double i = 0; i < 360; i += 360 / (((double)offset + 1) * 8)) {
+                QPoint point = location + GameObjectModel::geometricNeighbor(i, offset);
+                QVERIFY(k < ring.size());
+                QCOMPARE(ring[k], model.first->getObject(point.x(), point.y(), ObjectType::Tile));
+                ++k;
+            }
+            QCOMPARE(k, (int)ring.size());
+        }
+    }
+    delete model.first;
+}
+
+QTEST_GUILESS_MAIN(TestNeighborTable)
+#include "tst_neighbortable.moc"
@@ -0,0 +1,8 @@
+# Checks that a game comes back from a save file and that invalid files are not loaded.
+TARGET = tst_savegame
+CONFIG += testcase
+
+include(../tests.pri)
+
+SOURCES += \
+    tst_savegame.cpp
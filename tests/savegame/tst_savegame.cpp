@@ -0,0 +1,190 @@
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "model/gamerandom.h"
+#include "model/gameobjectmodel.h"
+#include "model/modelfactory.h"
+#include "model/savegame.h"
+
+/**
+ * @brief The TestSaveGame class checks that a game comes back from a save file as it was written, and that files
+ * that are not valid saves are not loaded.
+ */
+class TestSaveGame : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void roundTrip();
+    void random();
+    void rejects_data();
+    void rejects();
+
+private:
+    /// Writes bytes to a file of the temporary directory and returns its name.
+    QString writeFile(const QString &name, const QByteArray &bytes) const;
+    /// The data of every object of the level by tile, without the ids the model gives again when it is rebuilt.
+    static QList<QList<QList<QMap<DataRole, QVariant>>>> levelData(const GameObjectModel &model);
+
+    QTemporaryDir m_dir;
+    /// A valid save file of two levels
+    QByteArray m_save;
+};
+
+QString TestSaveGame::writeFile(const QString &name, const QByteArray &bytes) const {
+    QString fileName = m_dir.filePath(name);
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size()) {
+        return {};
+    }
+    return fileName;
+}
+
+QList<QList<QList<QMap<DataRole, QVariant>>>> TestSaveGame::levelData(const GameObjectModel &model) {
+    auto data = model.getAllData();
+    for(auto &column : data) {
+        for(auto &tile : column) {
+            for(auto &object : tile) {
+                object.remove(DataRole::Id);
+            }
+        }
+    }
+    return data;
+}
+
+void TestSaveGame::initTestCase() {
+    QVERIFY(m_dir.isValid());
+    SaveGame save;
+    save.currentLevel = 1;
+    for(int level = 0; level < 2; ++level) {
+        auto model = ObjectModelFactory::createModel(20, 4, 0.5f, level, 20, 30, level + 1);
+        save.levels.append(LevelSnapshot::capture(*model.first));
+        delete model.first;
+    }
+    save.seed = 7;
+    save.randomState = GameRandom().state();
+
+    QString fileName = m_dir.filePath("valid.sav");
+    QVERIFY(save.save(fileName));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    m_save = file.readAll();
+}
+
+void TestSaveGame::roundTrip() {
+    // A level that was played: poisoned tiles, enemies, health packs and the protagonist.
+    auto model = ObjectModelFactory::createModel(40, 6, 0.5f, 2, 25, 40, 42);
+    for(int x = 3; x < 10; ++x) {
+        model.first->getObject(x, 5, ObjectType::Tile)->setData(DataRole::PoisonLevel, 10 * x);
+    }
+    auto before = levelData(*model.first);
+
+    SaveGame save;
+    save.levels.append(LevelSnapshot::capture(*model.first));
+    save.randomState = GameRandom().state();
+    delete model.first;
+    QString fileName = m_dir.filePath("roundtrip.sav");
+    QVERIFY(save.save(fileName));
+
+    SaveGame loaded;
+    QVERIFY(loaded.load(fileName));
+    QCOMPARE(loaded.currentLevel, 0);
+    QCOMPARE(loaded.levels.size(), 1);
+    auto restored = loaded.levels[0].restore();
+    QCOMPARE(restored.first->getRowCount(), 25);
+    QCOMPARE(restored.first->getColumnCount(), 40);
+    // Every tile keeps its energy and poison, every occupant its type, position and data.
+    QVERIFY(levelData(*restored.first) == before);
+    QCOMPARE(restored.first->getObject(ObjectType::Protagonist).size(), 1);
+    delete restored.first;
+}
+
+void TestSaveGame::random() {
+    // The numbers drawn after loading are the ones the saved game would have drawn.
+    GameRandom game;
+    game.seed(1234);
+    for(int i = 0; i < 100; ++i) {
+        game.bounded(10);
+    }
+
+    SaveGame save;
+    auto model = ObjectModelFactory::createModel(0, 0, 0.5f, 0, 10, 10);
+    save.levels.append(LevelSnapshot::capture(*model.first));
+    delete model.first;
+    save.seed = game.gameSeed();
+    save.randomState = game.state();
+    QString fileName = m_dir.filePath("random.sav");
+    QVERIFY(save.save(fileName));
+
+    SaveGame loaded;
+    QVERIFY(loaded.load(fileName));
+    GameRandom restored;
+    QVERIFY(restored.restore(loaded.seed, loaded.randomState));
+    QCOMPARE(restored.gameSeed(), 1234u);
+    QCOMPARE(restored.levelSeed(3), game.levelSeed(3));
+    for(int i = 0; i < 100; ++i) {
+        QCOMPARE(restored.bounded(1000), game.bounded(1000));
+    }
+
+    // The same seed makes the same level.
+    auto first = ObjectModelFactory::createLevelData({3, 30, 4, 0.5f, 25, 40, game.levelSeed(3)});
+    auto second = ObjectModelFactory::createLevelData({3, 30, 4, 0.5f, 25, 40, restored.levelSeed(3)});
+    QVERIFY(first.heightmap == second.heightmap);
+    QCOMPARE(first.placements.size(), second.placements.size());
+    for(int i = 0; i < first.placements.size(); ++i) {
+        QCOMPARE((int)first.placements[i].type, (int)second.placements[i].type);
+        QCOMPARE(first.placements[i].position, second.placements[i].position);
+    }
+}
+
+void TestSaveGame::rejects_data() {
+    QTest::addColumn<QByteArray>("bytes");
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("header only") << m_save.left(24);
+    QTest::newRow("truncated") << m_save.left(m_save.size() - 1);
+
+    QByteArray magic = m_save;
+    magic[0] = 'X';
+    QTest::newRow("bad magic") << magic;
+
+    // The format version is the second 32 bit integer, little endian.
+    QByteArray version = m_save;
+    version[4] = char(SaveGame::VERSION + 1);
+    QTest::newRow("wrong version") << version;
+
+    QByteArray currentLevel = m_save;
+    currentLevel[12] = 2;
+    QTest::newRow("current level missing") << currentLevel;
+
+    // The random state is after the 24 bytes of the header.
+    QByteArray state = m_save;
+    state[24] = 'x';
+    QTest::newRow("bad random state") << state;
+
+    // A level the protagonist was removed from.
+    auto model = ObjectModelFactory::createModel(0, 0, 0.5f, 0, 10, 10);
+    delete model.first->getObject(ObjectType::Protagonist).at(0);
+    SaveGame save;
+    save.levels.append(LevelSnapshot::capture(*model.first));
+    save.randomState = GameRandom().state();
+    delete model.first;
+    QString fileName = m_dir.filePath("noprotagonist.sav");
+    QVERIFY(save.save(fileName));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QTest::newRow("zero protagonists") << file.readAll();
+}
+
+void TestSaveGame::rejects() {
+    QFETCH(QByteArray, bytes);
+    QString fileName = writeFile("invalid.sav", bytes);
+    QVERIFY(!fileName.isEmpty());
+
+    SaveGame save;
+    QVERIFY(!save.load(fileName));
+    QVERIFY(save.levels.isEmpty());
+    QVERIFY(save.randomState.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestSaveGame)
+#include "tst_savegame.moc"
@@ -0,0 +1,6 @@
+# Common settings of the test and benchmark targets, each of them builds the model in.
+QT += testlib
+CONFIG += c++20 console
+CONFIG -= app_bundle
+
+include($$PWD/../model/model.pri)
@@ -0,0 +1,8 @@
+# Tests and benchmarks of the model, build with: qmake tests/tests.pro && make && make check
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    benchmarks \
+    dstarlite \
+    neighbortable \
+    savegame
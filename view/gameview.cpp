@@ -1,6 +1,8 @@
 #include "gameview.h"
+#include "model/entityregistry.h"
 #include <QGraphicsPixmapItem>
 #include <QPropertyAnimation>
+#include <utility>
 
 GameView::GameView(QObject *parent)
     : QGraphicsScene(parent) {
@@ -19,67 +21,106 @@ void GameView::createScene(
     }
 
     m_tiles = QList<QList<GamePixmapItem *>>(gameObjects.size());
+    for(auto &column : m_tiles) {
+        column = QList<GamePixmapItem *>(gameObjects[0].size(), nullptr);
+    }
+    m_items.clear();
+    addTiles(QPoint(0, 0), gameObjects);
+}
+
+void GameView::addTiles(QPoint origin,
+                        const QList<QList<QList<QMap<DataRole, QVariant>>>> &gameObjects) {
+    for(int i = 0; i < gameObjects.size(); ++i) {
+        for(int j = 0; j < gameObjects[i].size(); ++j) {
+            // The tiles of cold chunks have no data, they are added when their chunk is materialized.
+            if(gameObjects[i][j].empty()) {
+                continue;
+            }
+            int x = origin.x() + i;
+            int y = origin.y() + j;
+            auto *item = m_renderer->renderGameObjects(gameObjects[i][j]);
+            item->setPos(x * item->pixmap().width(), y * item->pixmap().height());
+            m_tiles[x][y] = item; // Store the shared pointer in m_tiles
+            addItem(item);
 
-    for(int x = 0; x < gameObjects.size(); ++x) {
-        QList<GamePixmapItem *> rowItems(gameObjects[0].size());
-        m_tiles[x] = (rowItems);
-        for(int y = 0; y < gameObjects[0].size(); ++y) {
-            if(x < gameObjects.size() && y < gameObjects[x].size() && !gameObjects[x][y].empty()) {
-                auto *item = m_renderer->renderGameObjects(gameObjects[x][y]);
-                item->setPos(x * item->pixmap().width(), y * item->pixmap().height());
-                m_tiles[x][y] = item; // Store the shared pointer in m_tiles
-                addItem(item);
+            registerItem(item);
+            for(auto *child : item->childItems()) {
+                registerItem(dynamic_cast<GamePixmapItem *>(child));
             }
         }
     }
 }
 
+void GameView::removeTiles(QRect area) {
+    for(int x = area.left(); x <= area.right(); ++x) {
+        for(int y = area.top(); y <= area.bottom(); ++y) {
+            auto *item = std::exchange(m_tiles[x][y], nullptr);
+            if(!item) {
+                continue;
+            }
+            // The children go with the tile, none of them can be found by id anymore.
+            for(auto *child : item->childItems()) {
+                unregisterItem(dynamic_cast<GamePixmapItem *>(child));
+            }
+            unregisterItem(item);
+            delete item;
+        }
+    }
+}
+
 void GameView::setRenderer(QSharedPointer<Renderer> newRenderer) {
     m_renderer = std::move(newRenderer);
 }
 
-GamePixmapItem *GameView::getPixmapItem(int x, int y, QVariant type) {
-    auto tile = m_tiles[x][y];
-    switch(type.value<ObjectType>()) {
-    case ObjectType::Tile:
-        return tile;
-    default:
-        for(auto child : tile->childItems()) {
-            if(child->data((int)DataRole::Type) == type) {
-                return dynamic_cast<GamePixmapItem *>(child);
-            }
-        }
+void GameView::registerItem(GamePixmapItem *item) {
+    int index = EntityRegistry::index(item->data((int)DataRole::Id).toUInt());
+    if(index >= m_items.size()) {
+        m_items.resize(index + 1, nullptr);
+    }
+    m_items[index] = item;
+}
+
+void GameView::unregisterItem(GamePixmapItem *item) {
+    int index = EntityRegistry::index(item->data((int)DataRole::Id).toUInt());
+    if(index < m_items.size() && m_items[index] == item) {
+        m_items[index] = nullptr;
+    }
+}
+
+GamePixmapItem *GameView::getItem(quint32 id) const {
+    int index = EntityRegistry::index(id);
+    if(index >= m_items.size() || !m_items[index]) {
         return nullptr;
     }
+    // The slot might belong to an object that is gone, the generation tells them apart.
+    auto *item = m_items[index];
+    return item->data((int)DataRole::Id).toUInt() == id ? item : nullptr;
 }
 
-void GameView::dataChanged(QMap<DataRole, QVariant> objectData) {
+void GameView::dataChanged(QList<QMap<DataRole, QVariant>> changes) {
+    for(const auto &objectData : changes) {
+        applyChange(objectData);
+    }
+}
+
+void GameView::applyChange(const QMap<DataRole, QVariant> &objectData) {
     auto position = objectData[DataRole::Position].toPoint();
+    auto *changedObject = getItem(objectData[DataRole::Id].toUInt());
+    if(!changedObject) {
+        return;
+    }
+
     // The changes made here are only because the renderers have no access to the world.
     if(objectData[DataRole::LatestChange].value<DataRole>() == DataRole::Position) {
-        // The direction tells us where the object moved to. Since the data stored in it
-        // has the new position, we want to get the GamePixmapItem that is located in the tile
-        // opposite to the movement direction.
-        double direction = objectData[DataRole::Direction].toDouble();
-        double angleRad = -direction * M_PI / 180.0;
-
-        // Simple math, the angle is negative since (0,0) on an array is inverted wrt the
-        // QGraphicsScene the scene fills up to down while the model fills down to up.
-        int x = position.x() - round(cos(angleRad));
-        int y = position.y() - round(sin(angleRad));
-
-        // Perhaps an ID would be better in this case.
-        auto changedObject = getPixmapItem(x, y, objectData[DataRole::Type]);
-
-        QVariant type = QVariant::fromValue<ObjectType>(ObjectType::Tile);
-        changedObject->setParentItem(getPixmapItem(position.x(), position.y(), type));
+        // The data has the new position, the item is moved to the tile there.
+        changedObject->setParentItem(m_tiles[position.x()][position.y()]);
 
     } else if(objectData[DataRole::Destroyed].toBool()) {
         // This removes the object from the scene.
-        delete getPixmapItem(position.x(), position.y(), objectData[DataRole::Type]);
+        m_items[EntityRegistry::index(objectData[DataRole::Id].toUInt())] = nullptr;
+        delete changedObject;
     } else {
         // For every other change we pass it to the renderer.
-        auto *obj = getPixmapItem(position.x(), position.y(), objectData[DataRole::Type]);
-        m_renderer->renderGameObject(objectData, obj);
+        m_renderer->renderGameObject(objectData, changedObject);
     }
 }
@@ -34,30 +34,62 @@ public:
      */
     void setRenderer(QSharedPointer<Renderer> newRenderer);
 
+public slots:
+    /**
+     * @brief addTiles adds the items of a block of tiles, used when a chunk of a streamed level is materialized.
+     * @param origin is the location of the first tile of the block.
+     * @param gameObjects is the data of every object in the block, tiles with no data are skipped.
+     */
+    void addTiles(QPoint origin, const QList<QList<QList<QMap<DataRole, QVariant>>>> &gameObjects);
+
+    /**
+     * @brief removeTiles removes the items of a block of tiles and of everything on them, used when a chunk goes cold.
+     * @param area is the block of tiles.
+     */
+    void removeTiles(QRect area);
+
 private:
     /**
-     * @brief getPixmapItem gets a pxmp from the list in a point.
-     * @param x coordinate on the 2D plane.
-     * @param y coordinate on the 2D plane.
-     * @param type the GameObject type.
-     * @return Pointer to the Pixmap.
+     * @brief registerItem adds an item to the id table, with the id the renderer stored in its data.
+     * @param item is the item of a GameObject.
+     */
+    void registerItem(GamePixmapItem *item);
+    /**
+     * @brief unregisterItem removes an item from the id table, if the slot of its id still points to it.
+     * @param item is the item of a GameObject.
      */
-    GamePixmapItem *getPixmapItem(int x, int y, QVariant type);
+    void unregisterItem(GamePixmapItem *item);
+    /**
+     * @brief getItem finds the item of a GameObject.
+     * @param id is the DataRole::Id of the object.
+     * @return Pointer to the item, null if there is no item for that id.
+     */
+    GamePixmapItem *getItem(quint32 id) const;
+    /**
+     * @brief applyChange updates the scene with one change of a batch.
+     * @param objectData is the changed data of the object.
+     */
+    void applyChange(const QMap<DataRole, QVariant> &objectData);
     /**
      * @brief m_renderer stores the current Renderer of the scene.
      */
     QSharedPointer<Renderer> m_renderer;
     /**
-     * @brief m_tiles Store the graphical representation of each GameObject
+     * @brief m_tiles Store the graphical representation of each GameObject, null for the tiles of cold chunks.
      */
     QList<QList<GamePixmapItem *>> m_tiles;
+    /**
+     * @brief m_items The item of each GameObject, indexed by the slot of its id (EntityRegistry::index).
+     */
+    QList<GamePixmapItem *> m_items;
 
 public slots:
     /**
      * @brief dataChanged is the slot to monitor the change of properties of any object in the scene.
-     * @param objectData is the changed data of the object.
+     * The model sends all the changes of a tick at once, they are applied in one pass before the next paint.
+     * @param changes is the changed data of the objects, in the order the changes happened.
      */
-    void dataChanged(QMap<DataRole, QVariant> objectData);
+    void dataChanged(QList<QMap<DataRole, QVariant>> changes);
 };
 
 #endif // GAMEVIEW_H
@@ -163,6 +163,8 @@ void GameWindow::initializeCommands() {
     // Game commands
     gameCommands["q"] = {[this]() { QApplication::quit(); }, "Quit Game"};
     gameCommands["p"] = {[this]() { togglePause(); }, "Pause/Resume Game"};
+    gameCommands["save"] = {[this]() { m_controller->saveGame("./game.sav"); }, "Save Game"};
+    gameCommands["load"] = {[this]() { m_controller->loadGame("./game.sav"); }, "Load Game"};
     gameCommands["r"] = {[this]() {
                              QProcess::startDetached(qApp->arguments()[0], qApp->arguments());
                              QApplication::quit();
@@ -20,6 +20,7 @@ GamePixmapItem *Renderer::renderGameObjects(QList<QMap<DataRole, QVariant>> data
 GamePixmapItem *Renderer::renderGameObject(QMap<DataRole, QVariant> data) {
     auto *item = new GamePixmapItem();
     item->setData((int)DataRole::Type, data[DataRole::Type]);
+    item->setData((int)DataRole::Id, data[DataRole::Id]);
     return item;
 }
 